@@ -10,7 +10,7 @@ public class ClimbForge : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "MotionWarping" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "ClimbForgeMath", "InputCore", "EnhancedInput", "MotionWarping", "NavigationSystem", "AIModule", "Landscape", "Mover", "Json", "JsonUtilities", "AnimationBudgetAllocator", "AnimationSharing" });
 
 		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Public"));
 	}	
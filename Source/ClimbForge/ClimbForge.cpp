@@ -3,6 +3,23 @@
 // Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
 #include "ClimbForge.h"
 #include "Modules/ModuleManager.h"
+#include "ClimbAnimationBudget.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ClimbForge, "ClimbForge" );
+class FClimbForgeModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// The significance callback is global to every budgeted mesh, bind it once instead of per character.
+		USkeletalMeshComponentBudgeted::SetOnCalculateSignificance(FOnCalculateSignificance::CreateStatic(&ClimbAnimationBudget::CalculateSignificance));
+	}
+
+	virtual void ShutdownModule() override
+	{
+		USkeletalMeshComponentBudgeted::SetOnCalculateSignificance(FOnCalculateSignificance());
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FClimbForgeModule, ClimbForge, "ClimbForge" );
  
@@ -35,4 +35,10 @@ void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	bShouldMove = OwnerMovementComponent->GetCurrentAcceleration() != FVector::ZeroVector && GroundSpeed > 3.0f;
 	bIsFalling = OwnerMovementComponent->IsFalling();
 	bIsClimbing = OwnerMovementComponent->IsClimbing();
+	bIsHanging = OwnerMovementComponent->IsHanging();
+
+	LeftHandIKTarget = OwnerMovementComponent->GetLimbTarget(EClimbLimb::LeftHand);
+	RightHandIKTarget = OwnerMovementComponent->GetLimbTarget(EClimbLimb::RightHand);
+	LeftFootIKTarget = OwnerMovementComponent->GetLimbTarget(EClimbLimb::LeftFoot);
+	RightFootIKTarget = OwnerMovementComponent->GetLimbTarget(EClimbLimb::RightFoot);
 }
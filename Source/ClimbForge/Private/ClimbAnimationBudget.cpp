@@ -0,0 +1,110 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbAnimationBudget.h"
+
+#include "ClimbForgeCharacter.h"
+#include "ClimbForgeMovementComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarClimbAnimSignificanceDistance(
+		TEXT("ClimbForge.AnimBudget.SignificanceDistance"),
+		5000.0f,
+		TEXT("Distance from the closest local view at which a climber's animation significance reaches its minimum."));
+
+	TAutoConsoleVariable<float> CVarClimbAnimIdleSignificance(
+		TEXT("ClimbForge.AnimBudget.IdleSignificanceScale"),
+		0.5f,
+		TEXT("Significance scale of climbers that hang still on a wall or a ledge, their pose hardly changes."));
+
+	TAutoConsoleVariable<float> CVarClimbAnimTransitionSignificance(
+		TEXT("ClimbForge.AnimBudget.TransitionSignificanceScale"),
+		2.0f,
+		TEXT("Significance scale of climbers in a dash, vault or ledge climb. Their montage's root motion moves the capsule."));
+
+	// Below this speed a climber counts as holding still.
+	constexpr float ClimbIdleSpeed = 5.0f;
+
+	// Never zero, a climber that is skipped entirely would freeze mid climb.
+	constexpr float MinClimbSignificance = 0.01f;
+}
+
+EClimbAnimationState ClimbAnimationBudget::GetAnimationState(const AClimbForgeCharacter& Climber)
+{
+	const UClimbForgeMovementComponent* MovementComponent = Climber.GetClimbForgeMovementComponent();
+	if (MovementComponent == nullptr) return EClimbAnimationState::Ground;
+	if (MovementComponent->IsHanging()) return EClimbAnimationState::HangIdle;
+	if (!MovementComponent->IsClimbing()) return EClimbAnimationState::Ground;
+
+	// Same velocity the anim instance feeds the climb blend space with: Y to the right, Z up along the wall.
+	const FVector ClimbVelocity = MovementComponent->GetUnrotatedClimbingVelocity();
+	if (ClimbVelocity.SizeSquared() < FMath::Square(ClimbIdleSpeed)) return EClimbAnimationState::ClimbIdle;
+	if (FMath::Abs(ClimbVelocity.Z) >= FMath::Abs(ClimbVelocity.Y))
+	{
+		return ClimbVelocity.Z > 0.0f ? EClimbAnimationState::ClimbUp : EClimbAnimationState::ClimbDown;
+	}
+	return ClimbVelocity.Y > 0.0f ? EClimbAnimationState::ClimbRight : EClimbAnimationState::ClimbLeft;
+}
+
+float ClimbAnimationBudget::CalculateSignificance(USkeletalMeshComponentBudgeted* Component)
+{
+	const AActor* Owner = Component != nullptr ? Component->GetOwner() : nullptr;
+	const UWorld* World = Owner != nullptr ? Owner->GetWorld() : nullptr;
+	if (World == nullptr) return MinClimbSignificance;
+
+	const APawn* Pawn = Cast<APawn>(Owner);
+	if (Pawn != nullptr && Pawn->IsLocallyControlled()) return 1.0f;
+
+	double ClosestDistanceSquared = TNumericLimits<double>::Max();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr || !PlayerController->IsLocalController()) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(ViewLocation, Owner->GetActorLocation()));
+	}
+
+	const float SignificanceDistance = FMath::Max(CVarClimbAnimSignificanceDistance.GetValueOnGameThread(), 1.0f);
+	float Significance = 1.0f - FMath::Min(FMath::Sqrt(ClosestDistanceSquared) / SignificanceDistance, 1.0f);
+
+	// Budgeted meshes that are not climbers keep the plain distance significance.
+	if (const AClimbForgeCharacter* Climber = Cast<AClimbForgeCharacter>(Owner))
+	{
+		const UClimbForgeMovementComponent* MovementComponent = Climber->GetClimbForgeMovementComponent();
+		if (MovementComponent != nullptr && MovementComponent->IsInClimbTransition())
+		{
+			Significance *= CVarClimbAnimTransitionSignificance.GetValueOnGameThread();
+		}
+		else
+		{
+			const EClimbAnimationState State = GetAnimationState(*Climber);
+			if (State == EClimbAnimationState::ClimbIdle || State == EClimbAnimationState::HangIdle)
+			{
+				Significance *= CVarClimbAnimIdleSignificance.GetValueOnGameThread();
+			}
+		}
+	}
+	return FMath::Clamp(Significance, MinClimbSignificance, 1.0f);
+}
+
+void UClimbAnimationSharingStateProcessor::ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState,
+	uint8 OnDemandState, bool& bShouldProcess)
+{
+	const AClimbForgeCharacter* Climber = Cast<AClimbForgeCharacter>(InActor);
+	OutState = static_cast<int32>(Climber != nullptr ? ClimbAnimationBudget::GetAnimationState(*Climber) : EClimbAnimationState::Ground);
+	bShouldProcess = true;
+}
+
+UEnum* UClimbAnimationSharingStateProcessor::GetAnimationStateEnum_Implementation()
+{
+	return StaticEnum<EClimbAnimationState>();
+}
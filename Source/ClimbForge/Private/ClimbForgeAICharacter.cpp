@@ -0,0 +1,149 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbForgeAICharacter.h"
+#include "ClimbForgeMovementComponent.h"
+#include "NavLinkCustomComponent.h"
+#include "Engine/World.h"
+#include "Navigation/PathFollowingComponent.h"
+
+AClimbForgeAICharacter::AClimbForgeAICharacter(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer.DoNotCreateDefaultSubobject(AClimbForgeCharacter::CameraBoomName)
+	.DoNotCreateDefaultSubobject(AClimbForgeCharacter::FollowCameraName))
+{
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+}
+
+void AClimbForgeAICharacter::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (IsOnClimbNavLink())
+	{
+		UpdateClimbNavLink();
+	}
+}
+
+bool AClimbForgeAICharacter::StartClimbNavLink(UNavLinkCustomComponent& Link, UPathFollowingComponent& PathFollowing, const FVector& Destination)
+{
+	UClimbNavigationSubsystem* ClimbNavigation = GetWorld()->GetSubsystem<UClimbNavigationSubsystem>();
+	if (ClimbNavigation == nullptr || GetClimbForgeMovementComponent() == nullptr) return false;
+	if (!ClimbNavigation->FindClimbPath(GetActorLocation(), Destination, ClimbNavPath) || ClimbNavPath.Num() < 2) return false;
+
+	// The first point is where the agent already stands.
+	ClimbNavPointIndex = 1;
+	ClimbNavLinkStartTime = GetWorld()->GetTimeSeconds();
+	ClimbNavLink = &Link;
+	ClimbNavPathFollowing = &PathFollowing;
+	return true;
+}
+
+void AClimbForgeAICharacter::UpdateClimbNavLink()
+{
+	UClimbForgeMovementComponent* Movement = GetClimbForgeMovementComponent();
+	if (!ClimbNavLink.IsValid() || !ClimbNavPathFollowing.IsValid() || GetWorld()->TimeSince(ClimbNavLinkStartTime) > ClimbNavLinkTimeout)
+	{
+		if (Movement->IsClimbing())
+		{
+			Movement->ToggleClimbing(false);
+		}
+		FinishClimbNavLink();
+		return;
+	}
+
+	// Dashes, ledge climbs and vaults finish on their own.
+	if (Movement->IsInClimbTransition()) return;
+
+	const FClimbNavPathPoint& Point = ClimbNavPath[ClimbNavPointIndex];
+	const FVector ToPoint = Point.Location - GetActorLocation();
+	const bool bOnWall = Movement->IsClimbing() || Movement->IsHanging();
+	bool bReached = false;
+
+	switch (Point.ArrivedBy)
+	{
+	case EClimbNavLinkType::Mount:
+	case EClimbNavLinkType::DropDown:
+		// Walk up to the wall or the edge of the ledge top, then get onto the wall.
+		bReached = bOnWall;
+		if (!bReached)
+		{
+			AddMovementInput(ToPoint.GetSafeNormal2D());
+			if (ToPoint.Size2D() < ClimbNavAcceptanceRadius*2.0f)
+			{
+				Movement->ToggleClimbing(true);
+			}
+		}
+		break;
+	case EClimbNavLinkType::Climb:
+	case EClimbNavLinkType::Dash:
+	case EClimbNavLinkType::ClimbUp:
+		if (bOnWall)
+		{
+			// Climbing toward the ledge top climbs up once the ledge is reached.
+			const FVector AlongWall = FVector::VectorPlaneProject(ToPoint, Movement->GetClimbableSurfaceNormal());
+			bReached = Point.ArrivedBy != EClimbNavLinkType::ClimbUp && AlongWall.Size() < ClimbNavAcceptanceRadius;
+			if (!bReached)
+			{
+				AddMovementInput(AlongWall.GetSafeNormal());
+				if (Point.ArrivedBy == EClimbNavLinkType::Dash)
+				{
+					Movement->RequestClimbDash();
+				}
+			}
+		}
+		else
+		{
+			// Back on the ground after the ledge climb. Having fallen off the wall instead runs into the timeout.
+			bReached = Point.ArrivedBy == EClimbNavLinkType::ClimbUp && Movement->IsMovingOnGround();
+		}
+		break;
+	case EClimbNavLinkType::Dismount:
+		bReached = Movement->IsMovingOnGround();
+		if (bOnWall)
+		{
+			Movement->ToggleClimbing(false);
+		}
+		break;
+	case EClimbNavLinkType::Vault:
+		bReached = Movement->IsMovingOnGround() && ToPoint.Size2D() < ClimbNavAcceptanceRadius;
+		if (!bReached)
+		{
+			AddMovementInput(ToPoint.GetSafeNormal2D());
+			if (Movement->IsMovingOnGround())
+			{
+				Movement->TryStartVaulting();
+			}
+		}
+		break;
+	default:
+		bReached = true;
+		break;
+	}
+
+	if (bReached && ++ClimbNavPointIndex == ClimbNavPath.Num())
+	{
+		FinishClimbNavLink();
+	}
+}
+
+void AClimbForgeAICharacter::FinishClimbNavLink()
+{
+	if (UPathFollowingComponent* PathFollowing = ClimbNavPathFollowing.Get())
+	{
+		if (UNavLinkCustomComponent* Link = ClimbNavLink.Get())
+		{
+			PathFollowing->FinishUsingCustomLink(Link);
+		}
+		else
+		{
+			// The link went away with the climb graph, the path through it is gone too.
+			PathFollowing->AbortMove(*this, FPathFollowingResultFlags::InvalidPath);
+		}
+	}
+
+	ClimbNavPath.Reset();
+	ClimbNavPointIndex = INDEX_NONE;
+	ClimbNavLink.Reset();
+	ClimbNavPathFollowing.Reset();
+}
@@ -13,19 +13,58 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "ClimbForgeMovementComponent.h"
-#include "DebugHelper.h"
+#include "ClimbForgeStats.h"
+#include "ClimbReplaySubsystem.h"
+#include "ClimbAnimationBudget.h"
+#include "AnimationSharingManager.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "GameFramework/PlayerController.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
 #include "MotionWarpingComponent.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
+DECLARE_CYCLE_STAT(TEXT("Climbing Input Toggle"), STAT_ClimbingInputToggle, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climbing Camera"), STAT_ClimbingCamera, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climbing Camera Probes"), STAT_ClimbingCameraProbes, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dormant Climbers"), STAT_DormantClimbers, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Relevancy Line Of Sight Checks"), STAT_ClimbLineOfSightChecks, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shared Climber Animations"), STAT_SharedClimberAnimations, STATGROUP_ClimbForge);
+
+static FAutoConsoleCommandWithWorldAndArgs CVarBenchmarkClimbingInputToggle(
+	TEXT("ClimbForge.BenchmarkInputToggle"),
+	TEXT("Times climbing input toggles with the persistent climbing layer and with mapping context add/remove. Usage: ClimbForge.BenchmarkInputToggle [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+		if (AClimbForgeCharacter* Character = Cast<AClimbForgeCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+		{
+			Character->BenchmarkClimbingInputToggle(Iterations);
+		}
+	}));
+
 //////////////////////////////////////////////////////////////////////////
 // AClimbForgeCharacter
 
+FName AClimbForgeCharacter::CameraBoomName(TEXT("CameraBoom"));
+FName AClimbForgeCharacter::FollowCameraName(TEXT("FollowCamera"));
+
 AClimbForgeCharacter::AClimbForgeCharacter(const FObjectInitializer& ObjectInitializer)
-: Super(ObjectInitializer.SetDefaultSubobjectClass<UClimbForgeMovementComponent>(ACharacter::CharacterMovementComponentName))
+: Super(ObjectInitializer.SetDefaultSubobjectClass<UClimbForgeMovementComponent>(ACharacter::CharacterMovementComponentName)
+	.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(35.f, 90.0f);
+
+	// The Animation Budget Allocator throttles the anim graph of climbers that matter least, see ClimbAnimationBudget::CalculateSignificance.
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoCalculateSignificance(true);
+	}
 		
 	// Don't rotate when the controller rotates. Let that just affect the camera.
 	bUseControllerRotationPitch = false;
@@ -48,15 +87,29 @@ AClimbForgeCharacter::AClimbForgeCharacter(const FObjectInitializer& ObjectIniti
 	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
 
 	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-	CameraBoom->SetupAttachment(RootComponent);
-	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
-	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+	// Both camera components are optional so that AI climbers (see AClimbForgeAICharacter) do not pay for them.
+	CameraBoom = CreateOptionalDefaultSubobject<USpringArmComponent>(CameraBoomName);
+	if (CameraBoom != nullptr)
+	{
+		CameraBoom->SetupAttachment(RootComponent);
+		CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
+		CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+	}
 
 	// Create a follow camera
-	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
-	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	FollowCamera = CreateOptionalDefaultSubobject<UCameraComponent>(FollowCameraName);
+	if (FollowCamera != nullptr)
+	{
+		if (CameraBoom != nullptr)
+		{
+			FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
+		}
+		else
+		{
+			FollowCamera->SetupAttachment(RootComponent);
+		}
+		FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	}
 
 	MotionWarpingComponent = CreateDefaultSubobject<UMotionWarpingComponent>(TEXT("MotionWarpingComponent"));
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
@@ -66,6 +119,7 @@ AClimbForgeCharacter::AClimbForgeCharacter(const FObjectInitializer& ObjectIniti
 void AClimbForgeCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+	DefaultNetUpdateFrequency = GetNetUpdateFrequency();
 	if (ClimbForgeMovementComponent != nullptr)
 	{
 		ClimbForgeMovementComponent->OnEnterClimbingMode.BindUObject(this, &AClimbForgeCharacter::OnEnterClimbingMode);
@@ -73,6 +127,150 @@ void AClimbForgeCharacter::BeginPlay()
 	}
 }
 
+void AClimbForgeCharacter::DeactivateForPool()
+{
+	if (bIsInPool) return;
+	bIsInPool = true;
+	SetAnimationShared(false);
+
+	if (ClimbForgeMovementComponent != nullptr)
+	{
+		ClimbForgeMovementComponent->ResetClimbState();
+		ClimbForgeMovementComponent->SetComponentTickEnabled(false);
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	// The controller stays with the pawn so reactivating does not need to spawn or possess again.
+	if (Controller != nullptr)
+	{
+		Controller->StopMovement();
+		Controller->SetActorTickEnabled(false);
+	}
+}
+
+void AClimbForgeCharacter::ActivateFromPool(const FTransform& InTransform)
+{
+	if (!bIsInPool) return;
+	bIsInPool = false;
+
+	SetActorTransform(InTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetMesh()->SetComponentTickEnabled(true);
+
+	if (ClimbForgeMovementComponent != nullptr)
+	{
+		ClimbForgeMovementComponent->SetComponentTickEnabled(true);
+		ClimbForgeMovementComponent->SetDefaultMovementMode();
+	}
+
+	if (Controller != nullptr)
+	{
+		Controller->SetActorTickEnabled(true);
+	}
+	else
+	if (AutoPossessAI != EAutoPossessAI::Disabled)
+	{
+		SpawnDefaultController();
+	}
+}
+
+void AClimbForgeCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The owning client and the server run the climb queries themselves, only simulated proxies need the result.
+	DOREPLIFETIME_CONDITION(AClimbForgeCharacter, ReplicatedClimbState, COND_SimulatedOnly);
+}
+
+bool AClimbForgeCharacter::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	if (!Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation)) return false;
+	if (!IsClimbingOrHanging() || bAlwaysRelevant || RealViewer == Controller || ViewTarget == this || IsOwnedBy(ViewTarget)) return true;
+
+	// A climber high above or far below is only worth sending while the viewer can actually see it on the wall.
+	if (FMath::Abs(GetActorLocation().Z - SrcLocation.Z) < ClimbRelevancyVerticalDistance) return true;
+	return HasClimbLineOfSight(RealViewer, ViewTarget, SrcLocation);
+}
+
+float AClimbForgeCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget,
+	UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+	if (!IsClimbingOrHanging() || ViewTarget == this || ClimbNetPriorityHalvingHeight <= 0.0f) return Priority;
+
+	// The distance based priority of the engine treats a climber straight above the viewer like one next to it.
+	const float VerticalDistance = FMath::Abs(GetActorLocation().Z - ViewPos.Z);
+	return Priority * FMath::Pow(0.5f, VerticalDistance / ClimbNetPriorityHalvingHeight);
+}
+
+bool AClimbForgeCharacter::HasClimbLineOfSight(const AActor* Viewer, const AActor* ViewTarget, const FVector& ViewLocation) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	FClimbLineOfSight& LineOfSight = ClimbLineOfSightCache.FindOrAdd(Viewer);
+	if (LineOfSight.CheckTime > 0.0 && Now - LineOfSight.CheckTime < ClimbLineOfSightCacheTime) return LineOfSight.bHasLineOfSight;
+
+	INC_DWORD_STAT(STAT_ClimbLineOfSightChecks);
+
+	// Traced to the head, which stays clear of the climbed wall.
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbRelevancyLineOfSight), false, this);
+	QueryParams.AddIgnoredActor(ViewTarget);
+	LineOfSight.bHasLineOfSight = !GetWorld()->LineTraceTestByChannel(ViewLocation, GetPawnViewLocation(), ECC_Visibility, QueryParams);
+	LineOfSight.CheckTime = Now;
+	return LineOfSight.bHasLineOfSight;
+}
+
+void AClimbForgeCharacter::OnRep_ReplicatedClimbState()
+{
+	if (ClimbForgeMovementComponent != nullptr)
+	{
+		ClimbForgeMovementComponent->ApplyReplicatedClimbState(ReplicatedClimbState);
+	}
+}
+
+void AClimbForgeCharacter::ServerRequestClimbAction_Implementation(const FClimbPredictedActionRequest& Request)
+{
+	if (ClimbForgeMovementComponent != nullptr)
+	{
+		ClimbForgeMovementComponent->HandlePredictedActionRequest(Request);
+	}
+}
+
+void AClimbForgeCharacter::ClientResolveClimbAction_Implementation(const FClimbPredictedActionResult& Result)
+{
+	if (ClimbForgeMovementComponent != nullptr)
+	{
+		ClimbForgeMovementComponent->HandlePredictedActionResult(Result);
+	}
+}
+
+void AClimbForgeCharacter::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	UpdateClimbingCamera(DeltaSeconds);
+
+	if (HasAuthority() && GetNetMode() != NM_Standalone)
+	{
+		UpdateClimbReplication(DeltaSeconds);
+	}
+
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		UpdateAnimationSharing(DeltaSeconds);
+	}
+}
+
+void AClimbForgeCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetAnimationShared(false);
+	Super::EndPlay(EndPlayReason);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Input
 
@@ -81,15 +279,35 @@ void AClimbForgeCharacter::NotifyControllerChanged()
 	Super::NotifyControllerChanged();
 
 	AddInputMappingContext(DefaultMappingContext, 0);
+
+	BuildClimbingInputLayer();
+	bClimbingMappingContextIsPersistent = ClimbingInputLayer != nullptr;
+	if (bClimbingMappingContextIsPersistent)
+	{
+		// Registered once here, from now on climbing only flips bIsClimbingInputActive.
+		AddInputMappingContext(ClimbingInputLayer, 1);
+	}
 }
 
 void AClimbForgeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	// Set up action bindings
 	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent)) {
+
+		// The persistent climbing layer maps some climbing actions through copies, bind the handler to both.
+		BuildClimbingInputLayer();
+		const auto BindClimbingAction = [this, EnhancedInputComponent](const UInputAction* Action, const ETriggerEvent TriggerEvent, auto Handler)
+		{
+			EnhancedInputComponent->BindAction(Action, TriggerEvent, this, Handler);
+			const UInputAction* LayerAction = GetClimbingLayerAction(Action);
+			if (LayerAction != Action)
+			{
+				EnhancedInputComponent->BindAction(LayerAction, TriggerEvent, this, Handler);
+			}
+		};
 		
 		// Jumping
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &ACharacter::Jump);
+		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &AClimbForgeCharacter::HandleJump);
 		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
 
 		// Moving
@@ -99,9 +317,13 @@ void AClimbForgeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInpu
 		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AClimbForgeCharacter::Look);
 
 		// Climb Action
-		EnhancedInputComponent->BindAction(ClimbAction, ETriggerEvent::Started, this, &AClimbForgeCharacter::ClimbStarted);
-		EnhancedInputComponent->BindAction(ClimbMoveAction, ETriggerEvent::Triggered, this, &AClimbForgeCharacter::HandleClimbingMovement);
-		EnhancedInputComponent->BindAction(ClimbHopAction, ETriggerEvent::Started, this, &AClimbForgeCharacter::ClimbHopStarted);
+		BindClimbingAction(ClimbAction, ETriggerEvent::Started, &AClimbForgeCharacter::ClimbStarted);
+		BindClimbingAction(ClimbMoveAction, ETriggerEvent::Triggered, &AClimbForgeCharacter::HandleClimbingMovement);
+		BindClimbingAction(ClimbHopAction, ETriggerEvent::Started, &AClimbForgeCharacter::ClimbHopStarted);
+
+		// Releases of the held actions, for the input recording
+		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Completed, this, &AClimbForgeCharacter::HeldActionCompleted);
+		BindClimbingAction(ClimbMoveAction, ETriggerEvent::Completed, &AClimbForgeCharacter::HeldActionCompleted);
 	}
 	else
 	{
@@ -111,6 +333,9 @@ void AClimbForgeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInpu
 
 void AClimbForgeCharacter::HandleGroundMovement(const FInputActionValue& Value)
 {
+	RecordInput(EClimbRecordedAction::Move, Value);
+	if (bIsClimbingInputActive) return;
+
 	// input is a Vector2D
 	const FVector2D MovementVector = Value.Get<FVector2D>();
 
@@ -132,8 +357,18 @@ void AClimbForgeCharacter::HandleGroundMovement(const FInputActionValue& Value)
 	}	
 }
 
+void AClimbForgeCharacter::HandleJump()
+{
+	// The climb hop can share the jump key now that the climbing layer lets it through.
+	if (bIsClimbingInputActive) return;
+	Jump();
+}
+
 void AClimbForgeCharacter::HandleClimbingMovement(const FInputActionValue& Value)
 {
+	RecordInput(EClimbRecordedAction::ClimbMove, Value);
+	if (!bIsClimbingInputActive) return;
+
 	// input is a Vector2D
 	const FVector2D MovementVector = Value.Get<FVector2D>();
 	
@@ -163,25 +398,385 @@ void AClimbForgeCharacter::Look(const FInputActionValue& Value)
 
 void AClimbForgeCharacter::ClimbStarted(const FInputActionValue& Value)
 {
+	RecordInput(EClimbRecordedAction::Climb, Value);
 	if (ClimbForgeMovementComponent == nullptr) return;
-	ClimbForgeMovementComponent->ToggleClimbing(!ClimbForgeMovementComponent->IsClimbing());
+	// Pressing climb while on a wall or a ledge lets go of it.
+	const bool bIsOnWall = ClimbForgeMovementComponent->IsClimbing() || ClimbForgeMovementComponent->IsHanging();
+	ClimbForgeMovementComponent->ToggleClimbing(!bIsOnWall);
 }
 
 void AClimbForgeCharacter::ClimbHopStarted(const FInputActionValue& Value)
 {
-	if (ClimbForgeMovementComponent == nullptr) return;
-	Debug::Print(TEXT("Climb Dash Requested"), FColor::Red, 1);
+	RecordInput(EClimbRecordedAction::ClimbHop, Value);
+	if (ClimbForgeMovementComponent == nullptr || !bIsClimbingInputActive) return;
 	ClimbForgeMovementComponent->RequestClimbDash();
 }
 
+void AClimbForgeCharacter::HeldActionCompleted(const FInputActionInstance& Instance)
+{
+	if (!bIsRecordingInput) return;
+
+	const UInputAction* SourceAction = Instance.GetSourceAction();
+	const bool bIsClimbMove = SourceAction == ClimbMoveAction || SourceAction == GetClimbingLayerAction(ClimbMoveAction);
+	const EClimbRecordedAction Action = bIsClimbMove ? EClimbRecordedAction::ClimbMove : EClimbRecordedAction::Move;
+	RecordInput(Action, FInputActionValue(Instance.GetValue().GetValueType(), FVector::ZeroVector));
+}
+
+void AClimbForgeCharacter::RecordInput(const EClimbRecordedAction Action, const FInputActionValue& Value) const
+{
+	if (!bIsRecordingInput) return;
+
+	if (UClimbReplaySubsystem* Replay = GetWorld()->GetSubsystem<UClimbReplaySubsystem>())
+	{
+		Replay->RecordInput(Action, Value);
+	}
+}
+
+void AClimbForgeCharacter::ReplayInput(const EClimbRecordedAction Action, const FInputActionValue& Value)
+{
+	switch (Action)
+	{
+		case EClimbRecordedAction::Climb:		ClimbStarted(Value); break;
+		case EClimbRecordedAction::ClimbMove:	HandleClimbingMovement(Value); break;
+		case EClimbRecordedAction::ClimbHop:	ClimbHopStarted(Value); break;
+		case EClimbRecordedAction::Move:		HandleGroundMovement(Value); break;
+		default:								break;
+	}
+}
+
 void AClimbForgeCharacter::OnEnterClimbingMode()
 {
-	AddInputMappingContext(ClimbingMappingContext, 1);
+	SCOPE_CYCLE_COUNTER(STAT_ClimbingInputToggle);
+	bIsClimbingInputActive = true;
+	if (!bClimbingMappingContextIsPersistent)
+	{
+		AddInputMappingContext(ClimbingMappingContext, 1);
+	}
+	EnterClimbingCamera();
 }
 
 void AClimbForgeCharacter::OnExitClimbingMode()
 {
-	RemoveInputMappingContext(ClimbingMappingContext);
+	SCOPE_CYCLE_COUNTER(STAT_ClimbingInputToggle);
+	bIsClimbingInputActive = false;
+	if (!bClimbingMappingContextIsPersistent)
+	{
+		RemoveInputMappingContext(ClimbingMappingContext);
+	}
+	ExitClimbingCamera();
+}
+
+bool AClimbForgeCharacter::IsClimbingOrHanging() const
+{
+	return ClimbForgeMovementComponent != nullptr && (ClimbForgeMovementComponent->IsClimbing() || ClimbForgeMovementComponent->IsHanging());
+}
+
+void AClimbForgeCharacter::UpdateClimbReplication(const float DeltaSeconds)
+{
+	if (ClimbForgeMovementComponent == nullptr || DefaultNetUpdateFrequency <= 0.0f) return;
+
+	const bool bIsClimbing = IsClimbingOrHanging();
+	const bool bIsInTransition = bIsClimbing && ClimbForgeMovementComponent->IsInClimbTransition();
+	const float Speed = GetVelocity().Size();
+	const bool bIsIdle = bIsClimbing && !bIsInTransition && Speed < KINDA_SMALL_NUMBER;
+
+	// Plain climbing is slow and predictable, simulated proxies interpolate it fine from fewer updates.
+	float NetUpdateFrequency = DefaultNetUpdateFrequency;
+	if (bIsClimbing && !bIsInTransition)
+	{
+		const float SpeedRatio = FMath::Clamp(Speed / FMath::Max(ClimbForgeMovementComponent->GetMaxClimbSpeed(), 1.0f), 0.0f, 1.0f);
+		NetUpdateFrequency = FMath::Min(FMath::Lerp(IdleClimbNetUpdateFrequency, MovingClimbNetUpdateFrequency, SpeedRatio), DefaultNetUpdateFrequency);
+	}
+	if (!FMath::IsNearlyEqual(GetNetUpdateFrequency(), NetUpdateFrequency))
+	{
+		SetNetUpdateFrequency(NetUpdateFrequency);
+	}
+
+	// Send the start of a dash or ledge climb right away instead of waiting out the idle update interval.
+	if (bIsInTransition && !bWasInClimbTransition)
+	{
+		ForceNetUpdate();
+	}
+	bWasInClimbTransition = bIsInTransition;
+
+	ClimbIdleTime = bIsIdle ? ClimbIdleTime + DeltaSeconds : 0.0f;
+	if (!bIsClimbing && !ClimbLineOfSightCache.IsEmpty())
+	{
+		ClimbLineOfSightCache.Reset();
+	}
+	else
+	{
+		// Expired checks are traced again anyway. Dropping them also forgets viewers that left, e.g. disconnected players.
+		const double Now = GetWorld()->GetTimeSeconds();
+		for (auto It = ClimbLineOfSightCache.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value().CheckTime >= ClimbLineOfSightCacheTime)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	// Players stay awake: the movement acks and the predicted action results are sent on this actor's channel.
+	const bool bShouldBeDormant = bUseClimbDormancy && !IsPlayerControlled() && bIsIdle && ClimbIdleTime >= ClimbDormancyDelay;
+	if (bShouldBeDormant && !bIsClimbDormant)
+	{
+		bIsClimbDormant = true;
+		SetNetDormancy(DORM_DormantAll);
+	}
+	else
+	if (!bShouldBeDormant && bIsClimbDormant)
+	{
+		bIsClimbDormant = false;
+		SetNetDormancy(DORM_Awake);
+	}
+
+	if (bIsClimbDormant)
+	{
+		INC_DWORD_STAT(STAT_DormantClimbers);
+	}
+}
+
+void AClimbForgeCharacter::UpdateAnimationSharing(const float DeltaSeconds)
+{
+	if (!bUseAnimationSharing && !bIsAnimationShared) return;
+
+	AnimationSharingCheckTimer -= DeltaSeconds;
+	if (AnimationSharingCheckTimer <= 0.0f)
+	{
+		AnimationSharingCheckTimer = AnimationSharingCheckInterval;
+		bIsFarForAnimationSharing = IsFarFromLocalViews();
+	}
+
+	// Montages play on the climber's own anim instance. A shared climber would never get through its dash or ledge climb.
+	const bool bIsInTransition = ClimbForgeMovementComponent != nullptr && ClimbForgeMovementComponent->IsInClimbTransition();
+	const bool bShouldShare = bUseAnimationSharing && bIsFarForAnimationSharing && !IsPlayerControlled() && !bIsInTransition &&
+		ClimbAnimationBudget::GetAnimationState(*this) != EClimbAnimationState::Ground;
+	SetAnimationShared(bShouldShare);
+
+	if (bIsAnimationShared)
+	{
+		INC_DWORD_STAT(STAT_SharedClimberAnimations);
+	}
+}
+
+void AClimbForgeCharacter::SetAnimationShared(const bool bShared)
+{
+	if (bShared == bIsAnimationShared) return;
+
+	UAnimationSharingManager* AnimationSharingManager = UAnimationSharingManager::GetAnimationSharingManager(this);
+	if (bShared && AnimationSharingManager == nullptr && !AnimationSharingSetup.IsNull())
+	{
+		// The manager is per world, the first climber that shares sets it up.
+		if (UAnimationSharingManager::CreateAnimationSharingManager(this, AnimationSharingSetup.LoadSynchronous()))
+		{
+			AnimationSharingManager = UAnimationSharingManager::GetAnimationSharingManager(this);
+		}
+	}
+	if (AnimationSharingManager == nullptr) return;
+
+	if (bShared)
+	{
+		// Unregistering goes by actor, the handle is not needed.
+		AnimationSharingManager->RegisterActor(this, FUpdateActorHandle::CreateWeakLambda(this, [](int32) {}));
+	}
+	else
+	{
+		AnimationSharingManager->UnregisterActor(this);
+	}
+	bIsAnimationShared = bShared;
+}
+
+bool AClimbForgeCharacter::IsFarFromLocalViews() const
+{
+	bool bHasLocalView = false;
+	const float SharingDistanceSquared = FMath::Square(AnimationSharingDistance);
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr || !PlayerController->IsLocalController()) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		if (FVector::DistSquared(ViewLocation, GetActorLocation()) < SharingDistanceSquared) return false;
+		bHasLocalView = true;
+	}
+	return bHasLocalView;
+}
+
+void AClimbForgeCharacter::EnterClimbingCamera()
+{
+	if (!bUseClimbingCamera || CameraBoom == nullptr || bIsClimbingCameraActive) return;
+
+	bIsClimbingCameraActive = true;
+	DefaultCameraArmLength = CameraBoom->TargetArmLength;
+	DefaultCameraTargetOffset = CameraBoom->TargetOffset;
+	bDefaultCameraDoCollisionTest = CameraBoom->bDoCollisionTest;
+
+	// The boom would hit the climbed wall on every frame. Its probe is replaced by UpdateClimbingCamera.
+	CameraBoom->bDoCollisionTest = false;
+	ClimbingCameraArmLength = DefaultCameraArmLength;
+	ClimbingCameraWallNormal = FVector::ZeroVector;
+	ClimbingCameraProbeTimer = 0.0f;
+}
+
+void AClimbForgeCharacter::ExitClimbingCamera()
+{
+	if (!bIsClimbingCameraActive) return;
+
+	bIsClimbingCameraActive = false;
+	if (CameraBoom == nullptr) return;
+
+	CameraBoom->TargetArmLength = DefaultCameraArmLength;
+	CameraBoom->TargetOffset = DefaultCameraTargetOffset;
+	CameraBoom->bDoCollisionTest = bDefaultCameraDoCollisionTest;
+}
+
+void AClimbForgeCharacter::UpdateClimbingCamera(const float DeltaSeconds)
+{
+	if (!bIsClimbingCameraActive || CameraBoom == nullptr || ClimbForgeMovementComponent == nullptr) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ClimbingCamera);
+
+	const FVector SurfaceNormal = ClimbForgeMovementComponent->GetClimbableSurfaceNormal();
+	if (SurfaceNormal.IsNearlyZero()) return;
+
+	// Push the camera off the wall the movement component already swept so the boom starts clear of it.
+	const FVector TargetOffset = DefaultCameraTargetOffset + SurfaceNormal * ClimbingCameraWallOffset;
+	CameraBoom->TargetOffset = FMath::VInterpTo(CameraBoom->TargetOffset, TargetOffset, DeltaSeconds, ClimbingCameraInterpSpeed);
+
+	// Probe again only when the wall plane or the view changes, or the interval is up. Otherwise the last arm length is still good.
+	const float PlaneDistance = FVector::DotProduct(SurfaceNormal, ClimbForgeMovementComponent->GetClimbableSurfaceLocation());
+	const bool bWallPlaneChanged = FVector::DotProduct(SurfaceNormal, ClimbingCameraWallNormal) < ClimbingCameraPlaneNormalTolerance ||
+		FMath::Abs(PlaneDistance - ClimbingCameraWallPlaneDistance) > ClimbingCameraPlaneDistanceTolerance;
+
+	// Orbiting the camera while hanging still swings the boom into the wall just as well as moving does.
+	const FQuat ControlRotation = GetControlRotation().Quaternion();
+	const bool bViewChanged = FMath::RadiansToDegrees(ControlRotation.AngularDistance(ClimbingCameraProbeRotation)) > ClimbingCameraRotationTolerance;
+
+	ClimbingCameraProbeTimer -= DeltaSeconds;
+	if (bWallPlaneChanged || bViewChanged || ClimbingCameraProbeTimer <= 0.0f)
+	{
+		ClimbingCameraProbeTimer = ClimbingCameraProbeInterval;
+		ClimbingCameraWallNormal = SurfaceNormal;
+		ClimbingCameraWallPlaneDistance = PlaneDistance;
+		ClimbingCameraProbeRotation = ControlRotation;
+		ClimbingCameraArmLength = ProbeClimbingCameraArmLength();
+	}
+
+	// Ease out towards a longer arm so the view does not pop, but pull in at once like the spring arm does, never into the wall.
+	CameraBoom->TargetArmLength = FMath::Min(ClimbingCameraArmLength,
+		FMath::FInterpTo(CameraBoom->TargetArmLength, ClimbingCameraArmLength, DeltaSeconds, ClimbingCameraInterpSpeed));
+}
+
+float AClimbForgeCharacter::ProbeClimbingCameraArmLength() const
+{
+	INC_DWORD_STAT(STAT_ClimbingCameraProbes);
+
+	// Same probe the spring arm does, from the pivot back along the view direction.
+	const FVector Origin = CameraBoom->GetComponentLocation() + CameraBoom->TargetOffset;
+	const FVector DesiredCameraLocation = Origin - GetControlRotation().Vector() * DefaultCameraArmLength;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbingCameraProbe), false, this);
+	FHitResult Hit;
+	const bool bHit = GetWorld()->SweepSingleByChannel(Hit, Origin, DesiredCameraLocation, FQuat::Identity, CameraBoom->ProbeChannel,
+		FCollisionShape::MakeSphere(CameraBoom->ProbeSize), QueryParams);
+
+	return bHit ? DefaultCameraArmLength * Hit.Time : DefaultCameraArmLength;
+}
+
+void AClimbForgeCharacter::BuildClimbingInputLayer()
+{
+	if (ClimbingInputLayer != nullptr || !bKeepClimbingMappingContextRegistered) return;
+	if (DefaultMappingContext == nullptr || ClimbingMappingContext == nullptr) return;
+
+	// Every mapping of a copied action has to go through the copy, so find them all first.
+	for (const FEnhancedActionKeyMapping& ClimbMapping : ClimbingMappingContext->GetMappings())
+	{
+		if (ClimbMapping.Action == nullptr || !ClimbMapping.Action->bConsumeInput || ClimbingLayerActions.Contains(ClimbMapping.Action)) continue;
+
+		const bool bSharesKey = DefaultMappingContext->GetMappings().ContainsByPredicate([&ClimbMapping](const FEnhancedActionKeyMapping& DefaultMapping)
+		{
+			return DefaultMapping.Key == ClimbMapping.Key && DefaultMapping.Action != ClimbMapping.Action;
+		});
+		if (bSharesKey)
+		{
+			UInputAction* LayerAction = DuplicateObject<UInputAction>(ClimbMapping.Action, this);
+			LayerAction->bConsumeInput = false;
+			ClimbingLayerActions.Add(ClimbMapping.Action, LayerAction);
+		}
+	}
+
+	ClimbingInputLayer = NewObject<UInputMappingContext>(this, TEXT("ClimbingInputLayer"), RF_Transient);
+	for (const FEnhancedActionKeyMapping& ClimbMapping : ClimbingMappingContext->GetMappings())
+	{
+		if (ClimbMapping.Action == nullptr) continue;
+
+		FEnhancedActionKeyMapping& LayerMapping = ClimbingInputLayer->MapKey(GetClimbingLayerAction(ClimbMapping.Action), ClimbMapping.Key);
+		LayerMapping.Triggers = ClimbMapping.Triggers;
+		LayerMapping.Modifiers = ClimbMapping.Modifiers;
+	}
+}
+
+const UInputAction* AClimbForgeCharacter::GetClimbingLayerAction(const UInputAction* InAction) const
+{
+	const TObjectPtr<UInputAction>* LayerAction = ClimbingLayerActions.Find(InAction);
+	return LayerAction != nullptr ? LayerAction->Get() : InAction;
+}
+
+void AClimbForgeCharacter::BenchmarkClimbingInputToggle(const int32 InIterations)
+{
+	const APlayerController* PlayerController = Cast<APlayerController>(Controller);
+	if (PlayerController == nullptr || ClimbingMappingContext == nullptr) return;
+
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
+	if (Subsystem == nullptr) return;
+
+	const bool bWasClimbingInputActive = bIsClimbingInputActive;
+	const bool bWasPersistent = bClimbingMappingContextIsPersistent;
+	const bool bHadClimbingContext = Subsystem->HasMappingContext(ClimbingMappingContext);
+
+	// Both runs go through the same OnEnterClimbingMode and OnExitClimbingMode the movement component calls. The persistent run is
+	// what the game does with ClimbingInputLayer registered, the add/remove run what it did before. In game a mode
+	// change happens at most once a frame, and the control mapping rebuild an add/remove queues runs on the next input tick.
+	// That rebuild is forced after every toggle here, otherwise the toggles of one loop would share a single deferred rebuild.
+	FModifyContextOptions RebuildOptions;
+	RebuildOptions.bForceImmediately = true;
+	const auto TimeToggles = [this, Subsystem, &RebuildOptions, InIterations](const bool bPersistent)
+	{
+		bClimbingMappingContextIsPersistent = bPersistent;
+		const double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < InIterations; ++Iteration)
+		{
+			OnEnterClimbingMode();
+			if (!bPersistent)
+			{
+				Subsystem->RequestRebuildControlMappings(RebuildOptions);
+			}
+			OnExitClimbingMode();
+			if (!bPersistent)
+			{
+				Subsystem->RequestRebuildControlMappings(RebuildOptions);
+			}
+		}
+		return FPlatformTime::Seconds() - Start;
+	};
+
+	const double FlagSeconds = TimeToggles(true);
+	const double ContextSeconds = TimeToggles(false);
+	bClimbingMappingContextIsPersistent = bWasPersistent;
+	bIsClimbingInputActive = bWasClimbingInputActive;
+
+	if (bHadClimbingContext && !Subsystem->HasMappingContext(ClimbingMappingContext))
+	{
+		Subsystem->AddMappingContext(ClimbingMappingContext, 1);
+	}
+
+	// Each iteration is an enter and an exit.
+	UE_LOG(LogTemplateCharacter, Display, TEXT("Climbing input toggle over %d iterations: persistent layer %.1f ns/toggle, add/remove context %.1f ns/toggle. This character uses %s"),
+		InIterations, FlagSeconds * 1.0e9 / (2.0 * InIterations), ContextSeconds * 1.0e9 / (2.0 * InIterations),
+		bWasPersistent ? TEXT("the persistent layer") : TEXT("add/remove, bKeepClimbingMappingContextRegistered is off"));
 }
 
 void AClimbForgeCharacter::AddInputMappingContext(const UInputMappingContext* InContext, const int32 InPriority)
@@ -5,14 +5,42 @@
 #include "ClimbForgeMovementComponent.h"
 
 #include "ClimbForgeCharacter.h"
+#include "ClimbForgeStats.h"
 #include "ClimbingDirection.h"
+#include "ClimbMath.h"
+#include "ClimbQueryBudgetSubsystem.h"
 #include "CustomMovementMode.h"
 #include "DebugHelper.h"
-#include "KismetTraceUtils.h"
 #include "MotionWarpingComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/OverlapResult.h"
 #include "GameFramework/Character.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "VisualLogger/VisualLogger.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbForgeMovement, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Climb Contact Summary"), STAT_ClimbContactSummary, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Prefetch"), STAT_ClimbPrefetch, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Step"), STAT_ClimbStep, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Contacts Sweep"), STAT_ClimbContactsSweep, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Contacts Overlap"), STAT_ClimbContactsOverlap, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Simulated Climb Smoothing"), STAT_SimulatedClimbSmoothing, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Moving Surface Follow"), STAT_ClimbMovingSurfaceFollow, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Prefetch Hits"), STAT_ClimbPrefetchHits, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Prefetch Misses"), STAT_ClimbPrefetchMisses, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climbers On Moving Surfaces"), STAT_ClimbersOnMovingSurfaces, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Heightfield Queries"), STAT_ClimbHeightfieldQueries, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Normal Refinement Fans"), STAT_ClimbNormalRefinementFans, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Contacts Overlap Fallbacks"), STAT_ClimbContactsOverlapFallbacks, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Limb Probes"), STAT_ClimbLimbProbes, STATGROUP_ClimbForge);
+
+namespace
+{
+	// Every motion warp target the climbing montages use.
+	const FName ClimbWarpTargetNames[] = { FName("LedgeWarpOffset"), FName("VaultStart"), FName("VaultLand"), FName("HopHitPoint") };
+}
 
 #pragma region Overridden Functions
 
@@ -22,6 +50,7 @@ void UClimbForgeMovementComponent::BeginPlay()
 	ClimbQueryParams.AddIgnoredActor(GetOwner());
 
 	OwnerColliderCapsuleHalfHeight = GetCharacterOwner()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	ClimbQueryBudget = GetWorld()->GetSubsystem<UClimbQueryBudgetSubsystem>();
 	
 	OwnerActorAnimInstance = GetCharacterOwner()->GetMesh()->GetAnimInstance();
 	if (OwnerActorAnimInstance != nullptr)
@@ -33,12 +62,55 @@ void UClimbForgeMovementComponent::BeginPlay()
 
 void UClimbForgeMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	// Before the movement runs, so this tick's climb step already sees the queries that finished since the last one.
+	// Only the authority and the owning client make climb decisions, remote climbers are posed from the replicated state.
+	const bool bIsSimulatedProxy = CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy;
+
+	if (bPrefetchClimbQueries && IsClimbing() && !bIsSimulatedProxy)
+	{
+		UpdateClimbPrefetches();
+	}
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	TraceClimbableSurfaces();
 
-	if (bMoveToTargetAfterClimb)
+	// Hanging moves along the cached ledge segment and does not need the wall sweep.
+	// With a fixed climb step the wall only needs tracing again once a step has moved the character.
+	const bool bClimbStepPending = IsClimbing() && bUseFixedClimbStep && NumClimbStepsThisFrame == 0;
+	// The sweep drives the climbing itself and is not budgeted. Walking climbers only need it to be able to start climbing.
+	if (bIsSimulatedProxy)
+	{
+		SmoothReplicatedClimbState(DeltaTime);
+	}
+	else
+	if (!IsHanging() && !bClimbStepPending && (IsClimbing() || CanRunClimbQueries()))
+	{
+		TraceClimbableSurfaces();
+	}
+	NumClimbStepsThisFrame = 0;
+
+	if (bClimbRequestDeferred && CanRunClimbQueries())
+	{
+		ToggleClimbing(true);
+	}
+
+	if ((IsClimbing() || IsHanging()) && MovementBaseUtility::UseRelativeLocation(GetMovementBase()))
+	{
+		INC_DWORD_STAT(STAT_ClimbersOnMovingSurfaces);
+	}
+
+	RecordClimbStateToVisualLog();
+
+	// Motion warp targets are in world space. Keep the climb up warping to the ledge while the ledge moves.
+	if (bUsedMotionWarpForLedgeClimb && ClimbToLedgeTarget.IsBased())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ClimbMovingSurfaceFollow);
+		SetMotionWarpTarget("LedgeWarpOffset", ClimbToLedgeTarget.GetLocation());
+	}
+
+	// Simulated proxies get their velocity from the server, walking to the ledge target is only simulated where the movement is.
+	if (bMoveToTargetAfterClimb && CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		const FVector ToTarget = ClimbToLedgeTargetLocation - UpdatedComponent->GetComponentLocation();
+		const FVector ToTarget = GetClimbToLedgeTargetLocation() - UpdatedComponent->GetComponentLocation();
 		const float Distance = ToTarget.Size2D();
 		const FVector DesiredVelocity = ToTarget.GetSafeNormal2D() * 230.0f; //230.0f from the walk/run blendspace. walk anim is played at 230.0f
 		Velocity = DesiredVelocity;
@@ -49,16 +121,28 @@ void UClimbForgeMovementComponent::TickComponent(float DeltaTime, enum ELevelTic
 		{
 			bMoveToTargetAfterClimb = false;
 			Acceleration = FVector::ZeroVector;
-			ClimbToLedgeTargetLocation = FVector::ZeroVector;
+			ClimbToLedgeTarget.Reset();
 			LedgeSurfaceSlopeDegrees = 0.0f;
 			StopMovementImmediately();		
 		}
 	}
+
+	if (CharacterOwner->HasAuthority())
+	{
+		if (AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner))
+		{
+			Owner->SetReplicatedClimbState(BuildReplicatedClimbState());
+		}
+	}
 }
 
 void UClimbForgeMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
 {
-	if (IsClimbing())
+	// Climbing and hanging share the capsule setup and the climbing input, so moving between the two is not an enter or exit.
+	const bool bWasOnWall = PreviousMovementMode == MOVE_Custom && (PreviousCustomMode == MOVE_Climbing || PreviousCustomMode == MOVE_Hanging);
+	const bool bIsOnWall = IsClimbing() || IsHanging();
+
+	if (bIsOnWall && !bWasOnWall)
 	{
 		bOrientRotationToMovement = false;
 		// Half of 96.0f that is in AClimbForgeCharacter constructor.
@@ -66,10 +150,25 @@ void UClimbForgeMovementComponent::OnMovementModeChanged(EMovementMode PreviousM
 		OnEnterClimbingMode.ExecuteIfBound();
 	}
 
-	if (PreviousMovementMode == MOVE_Custom && PreviousCustomMode == MOVE_Climbing)
+	const bool bWasClimbing = PreviousMovementMode == MOVE_Custom && PreviousCustomMode == MOVE_Climbing;
+	if (bWasClimbing != IsClimbing())
+	{
+		ResetClimbStepInterpolation();
+	}
+
+	if (PreviousMovementMode == MOVE_Custom && PreviousCustomMode == MOVE_Hanging && !IsHanging())
+	{
+		LedgeSegment = FClimbLedgeSegment();
+		LedgeSegmentDistance = 0.0f;
+		BlockedLedgeSegmentEnd = 0;
+	}
+
+	if (bWasOnWall && !bIsOnWall)
 	{
 		bOrientRotationToMovement = true;		
 		CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(OwnerColliderCapsuleHalfHeight);
+		ClearLimbTargets();
+		ClearClimbPrefetches();
 
 		// Set Rotation to Stand
 		const FRotator StandRotation = FRotator(0.0f, UpdatedComponent->GetComponentRotation().Yaw, 0.0f);
@@ -88,6 +187,11 @@ void UClimbForgeMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
 	{
 		PhysClimbing(DeltaTime, Iterations);
 	}
+	else
+	if (IsHanging())
+	{
+		PhysHanging(DeltaTime, Iterations);
+	}
 	Super::PhysCustom(DeltaTime, Iterations);
 }
 
@@ -97,6 +201,10 @@ float UClimbForgeMovementComponent::GetMaxSpeed() const
 	{
 		return MaxClimbSpeed;
 	}
+	if (IsHanging())
+	{
+		return MaxHangShimmySpeed;
+	}
 	return Super::GetMaxSpeed();
 }
 
@@ -122,7 +230,7 @@ FVector UClimbForgeMovementComponent::ConstrainAnimRootMotionVelocity(const FVec
 #pragma endregion 
 
 #pragma region ClimbTraces
-TArray<FHitResult> UClimbForgeMovementComponent::CapsuleSweepTraceByChannel(const FVector& Start, const FVector& End, const bool bShowDebugShape, const bool bShowPersistent)
+TArray<FHitResult> UClimbForgeMovementComponent::CapsuleSweepTraceByChannel(const FVector& Start, const FVector& End)
 {
 	TArray<FHitResult> OutCapsuleTraceHitResult;
 
@@ -131,55 +239,119 @@ TArray<FHitResult> UClimbForgeMovementComponent::CapsuleSweepTraceByChannel(cons
 	const bool bHit = GetWorld()->SweepMultiByChannel(OutCapsuleTraceHitResult, Start, End, FQuat::Identity, ClimbableSurfaceTraceChannel, CollisionShape, 
 	ClimbQueryParams);
 
-	EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
-	if (bShowDebugShape)
-	{
-		DebugTraceType = EDrawDebugTrace::ForOneFrame;
-		if (bShowPersistent)
-		{
-			DebugTraceType = EDrawDebugTrace::Persistent;
-		}
-		DrawDebugCapsuleTraceMulti(GetWorld(), Start, End, ClimbCollisionCapsuleRadius, ClimbCollisionCapsuleHalfHeight, DebugTraceType, bHit,
-			OutCapsuleTraceHitResult, FLinearColor::Blue, FLinearColor::Red, 5.0f);
-	}	
+	// The visual logger only stores the shapes while it records, they are drawn when the recording is played back.
+	UE_VLOG_CAPSULE(CharacterOwner, LogClimbForgeMovement, VeryVerbose, End - FVector(0.0f, 0.0f, ClimbCollisionCapsuleHalfHeight),
+		ClimbCollisionCapsuleHalfHeight, ClimbCollisionCapsuleRadius, FQuat::Identity, bHit ? FColor::Red : FColor::Blue, TEXT(""));
 	return OutCapsuleTraceHitResult;
 }
 
-FHitResult UClimbForgeMovementComponent::LineTraceByChannel(const FVector& Start, const FVector& End, const bool bShowDebugShape, const bool bShowPersistent)
+TArray<FHitResult> UClimbForgeMovementComponent::CapsuleOverlapByChannel(const FVector& Location)
 {
-	FHitResult OutLineTrace;
+	SCOPE_CYCLE_COUNTER(STAT_ClimbContactsOverlap);
 
-	const bool bHit = GetWorld()->LineTraceSingleByChannel(OutLineTrace, Start, End, ClimbableSurfaceTraceChannel, ClimbQueryParams);
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(ClimbCollisionCapsuleRadius, ClimbCollisionCapsuleHalfHeight);
+	TArray<FOverlapResult> Overlaps;
+	GetWorld()->OverlapMultiByChannel(Overlaps, Location, FQuat::Identity, ClimbableSurfaceTraceChannel, CollisionShape, ClimbQueryParams);
 
-	EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
-	if (bShowDebugShape)
+	TArray<FHitResult> Contacts;
+	Contacts.Reserve(Overlaps.Num());
+	for (const FOverlapResult& Overlap : Overlaps)
 	{
-		DebugTraceType = EDrawDebugTrace::ForOneFrame;
-		if (bShowPersistent)
+		UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (Component == nullptr) continue;
+
+		// The direction from the closest point to the capsule center is the normal of the face the capsule is in front of.
+		FVector ClosestPoint;
+		const float Distance = Component->GetClosestPointOnCollision(Location, ClosestPoint);
+
+		// Negative for complex only collision, zero when the center is inside the geometry. Neither gives a normal.
+		if (Distance <= 0.0f)
 		{
-			DebugTraceType = EDrawDebugTrace::Persistent;
+			INC_DWORD_STAT(STAT_ClimbContactsOverlapFallbacks);
+			SCOPE_CYCLE_COUNTER(STAT_ClimbContactsSweep);
+			return CapsuleSweepTraceByChannel(Location, Location + UpdatedComponent->GetForwardVector());
 		}
-		DrawDebugLineTraceSingle(GetWorld(), Start, End, DebugTraceType, bHit, OutLineTrace, FLinearColor::Red, FLinearColor::Green, 5.0f);
+
+		FHitResult& Contact = Contacts.Emplace_GetRef(Location, Location);
+		Contact.bBlockingHit = Overlap.bBlockingHit;
+		Contact.Location = Location;
+		Contact.ImpactPoint = ClosestPoint;
+		Contact.Normal = Contact.ImpactNormal = (Location - ClosestPoint) / Distance;
+		Contact.Distance = Distance;
+		Contact.Item = Overlap.ItemIndex;
+		Contact.Component = Component;
+		Contact.HitObjectHandle = Overlap.OverlapObjectHandle;
 	}
-	
+
+	UE_VLOG_CAPSULE(CharacterOwner, LogClimbForgeMovement, VeryVerbose, Location - FVector(0.0f, 0.0f, ClimbCollisionCapsuleHalfHeight),
+		ClimbCollisionCapsuleHalfHeight, ClimbCollisionCapsuleRadius, FQuat::Identity, Contacts.IsEmpty() ? FColor::Blue : FColor::Red, TEXT("Overlap"));
+	return Contacts;
+}
+
+FHitResult UClimbForgeMovementComponent::LineTraceByChannel(const FVector& Start, const FVector& End)
+{
+	FHitResult OutLineTrace;
+
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(OutLineTrace, Start, End, ClimbableSurfaceTraceChannel, ClimbQueryParams);
+
+	UE_VLOG_SEGMENT(CharacterOwner, LogClimbForgeMovement, VeryVerbose, Start, bHit ? OutLineTrace.ImpactPoint : End,
+		bHit ? FColor::Green : FColor::Red, TEXT(""));
 	return OutLineTrace;
 }
+
+FHitResult UClimbForgeMovementComponent::GroundTraceByChannel(const FVector& Start, const FVector& End, UPrimitiveComponent* Ground)
+{
+	const FClimbHeightfield Heightfield = GetClimbHeightfield(Ground);
+	if (!Heightfield.IsValid() || !FClimbHeightfield::CanTrace(Start, End)) return LineTraceByChannel(Start, End);
+
+	INC_DWORD_STAT(STAT_ClimbHeightfieldQueries);
+	const FHitResult Hit = Heightfield.Trace(Start, End);
+
+	UE_VLOG_SEGMENT(CharacterOwner, LogClimbForgeMovement, VeryVerbose, Start, Hit.bBlockingHit ? Hit.ImpactPoint : End,
+		Hit.bBlockingHit ? FColor::Cyan : FColor::Red, TEXT("Heightfield"));
+	return Hit;
+}
+
+FClimbHeightfield UClimbForgeMovementComponent::GetClimbHeightfield(UPrimitiveComponent* Component) const
+{
+	return bUseHeightfieldQueries ? FClimbHeightfield(Component) : FClimbHeightfield();
+}
 #pragma endregion
 
 #pragma region ClimbCore
 
 void UClimbForgeMovementComponent::ToggleClimbing(const bool bEnableClimb)
 {
+	bClimbRequestDeferred = false;
+
 	if (bEnableClimb)
 	{
+		if (!CanRunClimbQueries())
+		{
+			bClimbRequestDeferred = true;
+			return;
+		}
+
+		// Nothing to climb or vault from the air but a ledge within reach can still be grabbed.
+		if (IsFalling())
+		{
+			TryStartHanging();
+		}
+		else
 		if (CanStartClimbing())
 		{
-			PlayMontage(IdleToClimbMontage);
+			if (StartPredictedAction(EClimbPredictedAction::ClimbStart, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector))
+			{
+				SendPredictedAction(EClimbPredictedAction::ClimbStart, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector);
+			}
 		}
 		else
 		if (CanStartClimbingDown())
 		{
-			PlayMontage(ClimbDownFromLegdeMontage);
+			if (StartPredictedAction(EClimbPredictedAction::ClimbDown, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector))
+			{
+				SendPredictedAction(EClimbPredictedAction::ClimbDown, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector);
+			}
 		}
 		else
 		{
@@ -189,7 +361,10 @@ void UClimbForgeMovementComponent::ToggleClimbing(const bool bEnableClimb)
 	else
 	{
 		// Stop climb
-		StopClimbing();
+		if (StartPredictedAction(EClimbPredictedAction::LetGo, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector))
+		{
+			SendPredictedAction(EClimbPredictedAction::LetGo, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector);
+		}
 	}
 }
 
@@ -198,35 +373,25 @@ bool UClimbForgeMovementComponent::CanStartClimbing()
 	if (IsFalling()) return false;
 	//if (!TraceClimbableSurfaces()) return false;
 
-	// Check if it is a climbable surface by checking it's slope in degrees.
-	for (FHitResult& Hit : ClimbableSurfacesHits)
-	{
-		// This is in theory the surface (to climb) normal projected onto a horizontal plane as
-		// GetSafeNormal2D uses on X and Y components.
-		const FVector HorizontalProjectedNormal = Hit.Normal.GetSafeNormal2D();
+	// Check if it is a climbable surface by checking it's slope in degrees. The contact summary already holds the hit
+	// that faces the character the most and is not a ceiling or floor, if that one is too steep all the others are as well.
+	const int32 Candidate = ClimbContactSummary.BestCandidate;
+	if (Candidate == INDEX_NONE || ClimbContactSummary.BestCandidateAngleInDegrees >= MinimumClimbableAngleInDegrees) return false;
 
-		// The slope or angle between the character forward and the hit normal. This determines if the surface is climbable.
-		const float HorizontalDot = FVector::DotProduct(UpdatedComponent->GetForwardVector(), -HorizontalProjectedNormal);
-		// This is theta = acos(a.b/|a|x|b|) as both the vectors are normalized or unit vector their magnitudes will be 1 thus 
-		// theta = acos(a.b)
-		const float AngleInDegrees = FMath::RadiansToDegrees(FMath::Acos(HorizontalDot));
+	// Calculate the length of the trace to use for checking if there is a surface at eye height. This check is for the surface that give
+	// a valid hit from the ClimbableSurfacesHits but are like small ledges that are not climbable.
+	constexpr float BaseLength = 80.0f;
+	const float SteepnessMultiplier = 1.0f + (1.0f - ClimbContactSummary.BestCandidateSteepness) * 5.0f;
 
-		// Detect if the surface to climb is a ceiling or not. If a ceiling then don't climb.
-		const float Steepness = FVector::DotProduct(Hit.Normal, HorizontalProjectedNormal);
-		// IF nearly zero means that the normal of this surface is parallel to upvector so it can be a ceiling or a floor
-		const bool bIsCeilingOrFloor = FMath::IsNearlyZero(Steepness);
+	const FHitResult SurfaceAtEyeHeightTraceResult = TraceFromEyeHeight(BaseLength * SteepnessMultiplier);
 
-		// Calculate the length of the trace to use for checking if there is a surface at eye height. This check is for the surface that give
-		// a valid hit from the ClimbableSurfacesHits but are like small ledges that are not climbable.
-		constexpr float BaseLength = 80.0f;
-		const float SteepnessMultiplier = 1.0f + (1.0f - Steepness) * 5.0f;
-	
-		FHitResult SurfaceAtEyeHeightTraceResult = TraceFromEyeHeight(BaseLength * SteepnessMultiplier);
-		
-		if (AngleInDegrees < MinimumClimbableAngleInDegrees && !bIsCeilingOrFloor && SurfaceAtEyeHeightTraceResult.bBlockingHit)
-		{
-			return true;
-		}
+	UE_VLOG(CharacterOwner, LogClimbForgeMovement, Verbose, TEXT("CanStartClimbing hit %s: angle %.1f, eye height hit %d"),
+		*GetNameSafe(ClimbableSurfacesHits[Candidate].GetActor()), ClimbContactSummary.BestCandidateAngleInDegrees,
+		SurfaceAtEyeHeightTraceResult.bBlockingHit);
+
+	if (SurfaceAtEyeHeightTraceResult.bBlockingHit)
+	{
+		return true;
 	}
 
 	
@@ -250,12 +415,14 @@ bool UClimbForgeMovementComponent::CanStartClimbingDown()
 	 const FVector WalkableSurfaceTraceStart = UpdatedComponent->GetComponentLocation() + ComponentForward * ClimbDownWalkableSurfaceTraceOffset;
 	 const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 125.f;
 	
-	 FHitResult WalkableSurfaceHit = LineTraceByChannel(WalkableSurfaceTraceStart,WalkableSurfaceTraceEnd);
+	 // On terrain both probes are answered from the heightfield of the floor.
+	 UPrimitiveComponent* Floor = CurrentFloor.HitResult.GetComponent();
+	 FHitResult WalkableSurfaceHit = GroundTraceByChannel(WalkableSurfaceTraceStart,WalkableSurfaceTraceEnd, Floor);
 	
 	 const FVector LedgeTraceStart = WalkableSurfaceHit.TraceStart + ComponentForward * ClimbDownLedgeTraceOffset;
 	 const FVector LedgeTraceEnd = LedgeTraceStart + DownVector * 200.f;
 	
-	 FHitResult LedgeTraceHit = LineTraceByChannel(LedgeTraceStart,LedgeTraceEnd);
+	 FHitResult LedgeTraceHit = GroundTraceByChannel(LedgeTraceStart,LedgeTraceEnd, Floor);
 	
 	 if(WalkableSurfaceHit.bBlockingHit && !LedgeTraceHit.bBlockingHit)
 	 {
@@ -274,39 +441,12 @@ bool UClimbForgeMovementComponent::ShouldStopClimbing()
 	//   -   1.0: Vectors are perfectly aligned (pointing in the same direction).
 	//   -   0.0: Vectors are perpendicular (90 degrees apart).
 	//   -  -1.0: Vectors are perfectly opposite (180 degrees apart).
-	float DotProduct = FVector::DotProduct(ClimbableSurfaceNormal, FVector::UpVector);
 
-	// Define Thresholds for Non-Climbable Surfaces.
-	// These values determine what is considered a "floor" or a "ceiling".
-	// You will likely need to fine-tune these based on your game's specific needs and level design.
+	// See ClimbMath::FloorDotProductThreshold and CeilingDotProductThreshold.
 
-	// Threshold for a non-climbable floor:
-	// If the normal points mostly UP (aligned with PlayerUpVector), it's a floor.
-	// A dot product close to 1.0 indicates a floor.
-	const float FloorDotProductThreshold = 0.8f; // Example: Normal is within ~37 degrees of pure up
-
-	// Threshold for a non-climbable ceiling:
-	// If the normal points mostly DOWN (opposite to PlayerUpVector), it's a ceiling.
-	// A dot product close to -1.0 indicates a ceiling.
-	const float CeilingDotProductThreshold = -0.985f; // Example: Normal is within ~37 degrees of pure down
-
-	// Determine if the surface is climbable.
-	bool bIsClimbableSurface = true; // Assume climbable by default
-
-	if (DotProduct < CeilingDotProductThreshold || DotProduct > FloorDotProductThreshold)
-	{
-	    // The surface normal is pointing predominantly upwards. This is a floor.
-	    bIsClimbableSurface = false;
-	    //UE_LOG(LogTemp, Log, TEXT("Surface is a non-climbable Floor or Ceiling. DotProduct: %f"), DotProduct);
-	}
-	else
-	{
-	    // The surface normal is mostly horizontal relative to the player's up vector.
-	    // This means it's a wall or a climbable slope.
-	    bIsClimbableSurface = true;
-	   //UE_LOG(LogTemp, Log, TEXT("Surface is a Climbable Wall/Slope. DotProduct: %f"), DotProduct);
-	}
-	return !bIsClimbableSurface;
+	// A wall or a climbable slope has a normal that is mostly horizontal relative to the player's up vector.
+	return ClimbMath::IsFloorOrCeilingNormal(ClimbableSurfaceNormal, ClimbMath::FloorDotProductThreshold,
+		ClimbMath::CeilingDotProductThreshold);
 }
 
 void UClimbForgeMovementComponent::StartClimbing()
@@ -314,8 +454,10 @@ void UClimbForgeMovementComponent::StartClimbing()
 	SetMovementMode(MOVE_Custom, MOVE_Climbing);
 }
 
-void UClimbForgeMovementComponent::StopClimbing()
+void UClimbForgeMovementComponent::StopClimbing(const EClimbStopReason Reason)
 {
+	CLIMB_TELEMETRY(EClimbTelemetryEventType::ClimbStop, CharacterOwner, Reason);
+	UE_VLOG(CharacterOwner, LogClimbForgeMovement, Log, TEXT("Stop climbing: %s"), LexToString(Reason));
 	SetMovementMode(MOVE_Falling);
 }
 
@@ -324,11 +466,27 @@ bool UClimbForgeMovementComponent::IsClimbing() const
 	return MovementMode == MOVE_Custom && CustomMovementMode == MOVE_Climbing;
 }
 
+bool UClimbForgeMovementComponent::IsHanging() const
+{
+	return MovementMode == MOVE_Custom && CustomMovementMode == MOVE_Hanging;
+}
+
+bool UClimbForgeMovementComponent::IsInClimbTransition() const
+{
+	return ActiveClimbDashDirection != EClimbingDirection::Idle || PendingPredictedAction.Action != EClimbPredictedAction::None ||
+		(CharacterOwner != nullptr && CharacterOwner->IsPlayingRootMotion());
+}
+
 FVector UClimbForgeMovementComponent::GetUnrotatedClimbingVelocity() const
 {
 	return UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), Velocity);
 }
 
+bool UClimbForgeMovementComponent::CanRunClimbQueries() const
+{
+	return ClimbQueryBudget == nullptr || ClimbQueryBudget->TryAdmit(*this);
+}
+
 bool UClimbForgeMovementComponent::TraceClimbableSurfaces()
 {
 	// Don't want to start right from the character location but a few units in front.
@@ -339,16 +497,290 @@ bool UClimbForgeMovementComponent::TraceClimbableSurfaces()
 	// In this case 2 start and end as the forward vector is a unit vector.
 	const FVector End = Start + UpdatedComponent->GetForwardVector();
 
-	ClimbableSurfacesHits = CapsuleSweepTraceByChannel(Start, End);
+	// Starting to climb is decided on the spot, only an ongoing climb can work with a frame old sweep.
+	const bool bUseAsyncSweep = bUseAsyncClimbTraces && IsClimbing();
+	const FClimbPrefetchedQuery* Prefetch = bPrefetchClimbQueries && IsClimbing() && !bUseAsyncSweep ?
+		FindClimbPrefetch(UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetForwardVector()) : nullptr;
+	if (bUseAsyncSweep)
+	{
+		ExchangeAsyncClimbSweep(Start, End);
+	}
+	else
+	if (Prefetch != nullptr)
+	{
+		ClimbableSurfacesHits = Prefetch->Hits;
+	}
+	else
+	if (ClimbContactGeneration == EClimbContactGeneration::Overlap)
+	{
+		PendingClimbSweepHandle.Invalidate();
+		ClimbableSurfacesHits = CapsuleOverlapByChannel(Start);
+	}
+	else
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ClimbContactsSweep);
+		PendingClimbSweepHandle.Invalidate();
+		ClimbableSurfacesHits = CapsuleSweepTraceByChannel(Start, End);
+	}
+	UpdateClimbContactSummary();
+
+	// The limb probes go out as one async batch together with the climb sweep, so the control rig never has to trace on its own.
+	if (bGenerateLimbTargets && IsClimbing())
+	{
+		UpdateLimbTargets();
+	}
 	return !ClimbableSurfacesHits.IsEmpty();
 }
 
-FHitResult UClimbForgeMovementComponent::TraceFromEyeHeight(const float TraceDistance, const float TraceStartOffset, const bool bShowDebugShape, const bool bShowPersistent)
+void UClimbForgeMovementComponent::UpdateClimbPrefetches()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimbPrefetch);
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	// Past this the climber has either used the result or gone somewhere else.
+	const double MaxAge = FMath::Max(2.0 * ClimbPrefetchLookaheadTime, 0.1);
+
+	for (FClimbPrefetchedQuery& Query : ClimbPrefetches)
+	{
+		if (!Query.IsInUse()) continue;
+
+		if (Now - Query.IssueTime > MaxAge)
+		{
+			Query = FClimbPrefetchedQuery();
+			continue;
+		}
+
+		FTraceDatum Result;
+		if (Query.Handle.IsValid() && World->QueryTraceData(Query.Handle, Result))
+		{
+			Query.Handle.Invalidate();
+			if (Query.Kind == EClimbPrefetchQuery::Surface)
+			{
+				Query.Hits = MoveTemp(Result.OutHits);
+				Query.bIsReady = true;
+			}
+			else
+			{
+				AdvanceLedgePrefetch(Query, Result);
+			}
+		}
+	}
+
+	// Standing still, the queries for the current spot are all that is needed.
+	const FVector UnrotatedVelocity = GetUnrotatedClimbingVelocity();
+	if (UnrotatedVelocity.IsNearlyZero(10.0f)) return;
+
+	const FVector PredictedLocation = UpdatedComponent->GetComponentLocation() + Velocity * ClimbPrefetchLookaheadTime;
+	const FVector Forward = UpdatedComponent->GetForwardVector();
+	const FVector Up = UpdatedComponent->GetUpVector();
+
+	IssueClimbPrefetch(EClimbPrefetchQuery::Surface, PredictedLocation, Forward, Up);
+
+	// The ledge is only climbed when moving up, see HasReachedTheLedge.
+	if (UnrotatedVelocity.Z > 10.0f)
+	{
+		IssueClimbPrefetch(EClimbPrefetchQuery::Ledge, PredictedLocation, Forward, Up);
+	}
+}
+
+void UClimbForgeMovementComponent::IssueClimbPrefetch(const EClimbPrefetchQuery Kind, const FVector& Location, const FVector& Forward,
+	const FVector& Up)
+{
+	// One query per spot is enough, the climber passes through the tolerance over several frames.
+	// Takes a free slot, or the oldest one when all are in use.
+	int32 Slot = 0;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(ClimbPrefetches); ++Index)
+	{
+		const FClimbPrefetchedQuery& Query = ClimbPrefetches[Index];
+		if (!Query.IsInUse())
+		{
+			Slot = Index;
+			continue;
+		}
+
+		if (Query.Kind == Kind && FVector::DistSquared(Query.Location, Location) < FMath::Square(ClimbPrefetchTolerance)) return;
+
+		if (ClimbPrefetches[Slot].IsInUse() && Query.IssueTime < ClimbPrefetches[Slot].IssueTime)
+		{
+			Slot = Index;
+		}
+	}
+
+	FClimbPrefetchedQuery& Query = ClimbPrefetches[Slot];
+	Query = FClimbPrefetchedQuery();
+	Query.Kind = Kind;
+	Query.Location = Location;
+	Query.Forward = Forward;
+	Query.IssueTime = GetWorld()->GetTimeSeconds();
+
+	// The same queries TraceClimbableSurfaces and HasReachedTheLedge make, only from the predicted location.
+	if (Kind == EClimbPrefetchQuery::Surface)
+	{
+		const FVector Start = Location + Forward * 25.0f;
+		const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(ClimbCollisionCapsuleRadius, ClimbCollisionCapsuleHalfHeight);
+		Query.Handle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Multi, Start, Start + Forward, FQuat::Identity,
+			ClimbableSurfaceTraceChannel, CollisionShape, ClimbQueryParams);
+	}
+	else
+	{
+		const float TraceDistance = CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleRadius() * 2.5f;
+		const FVector Start = Location + Up * (CharacterOwner->BaseEyeHeight + 20.0f);
+		Query.Handle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start + Forward * TraceDistance,
+			ClimbableSurfaceTraceChannel, ClimbQueryParams);
+	}
+}
+
+void UClimbForgeMovementComponent::AdvanceLedgePrefetch(FClimbPrefetchedQuery& Query, const FTraceDatum& Result)
+{
+	const FHitResult* Hit = Result.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+	const FVector Up = UpdatedComponent->GetUpVector();
+
+	switch (Query.LedgeStep)
+	{
+	case EClimbLedgePrefetchStep::EyeTrace:
+		{
+			Query.bWallAtEyeHeight = Hit != nullptr;
+			if (Query.bWallAtEyeHeight) break;
+
+			// The lip is in reach from there, look for the walkable top past it like HasReachedTheLedge does.
+			const FVector TopStart = Result.End + Up*OwnerColliderCapsuleHalfHeight;
+			Query.LedgeStep = EClimbLedgePrefetchStep::TopTrace;
+			Query.Handle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, TopStart, TopStart + Up*-2.0f*OwnerColliderCapsuleHalfHeight,
+				ClimbableSurfaceTraceChannel, ClimbQueryParams);
+			return;
+		}
+	case EClimbLedgePrefetchStep::TopTrace:
+		{
+			if (Hit == nullptr || Hit->Normal.Z < GetWalkableFloorZ()) break;
+
+			Query.LedgeTopHit = *Hit;
+			const FVector TopStart = Result.Start;
+			const FVector CapsuleStart = FVector(Query.Location.X, TopStart.Y, TopStart.Z);
+			const FCollisionShape CapsuleCollision = FCollisionShape::MakeCapsule(ClimbCollisionCapsuleRadius, OwnerColliderCapsuleHalfHeight);
+			Query.LedgeStep = EClimbLedgePrefetchStep::HeadroomSweep;
+			Query.Handle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, CapsuleStart, TopStart, FQuat::Identity,
+				ClimbableSurfaceTraceChannel, CapsuleCollision, ClimbQueryParams);
+			return;
+		}
+	case EClimbLedgePrefetchStep::HeadroomSweep:
+		Query.bLedgeTopBlocked = Hit != nullptr;
+		break;
+	}
+	Query.bIsReady = true;
+}
+
+const FClimbPrefetchedQuery* UClimbForgeMovementComponent::FindClimbPrefetch(const FVector& Location, const FVector& Forward) const
+{
+	const float ToleranceSquared = FMath::Square(ClimbPrefetchTolerance);
+	for (const FClimbPrefetchedQuery& Query : ClimbPrefetches)
+	{
+		if (Query.bIsReady && Query.Kind == EClimbPrefetchQuery::Surface && FVector::DistSquared(Query.Location, Location) <= ToleranceSquared &&
+			FVector::DotProduct(Query.Forward, Forward) > 0.995f)
+		{
+			INC_DWORD_STAT(STAT_ClimbPrefetchHits);
+			return &Query;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_ClimbPrefetchMisses);
+	return nullptr;
+}
+
+const FClimbPrefetchedQuery* UClimbForgeMovementComponent::FindLedgePrefetch() const
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector Forward = UpdatedComponent->GetForwardVector();
+	const FVector Up = UpdatedComponent->GetUpVector();
+
+	// A query made lower than the climber can still hit the wall below the lip, only the ones at or above it tell where the lip is.
+	const FClimbPrefetchedQuery* Closest = nullptr;
+	double ClosestHeight = OwnerColliderCapsuleHalfHeight;
+	for (const FClimbPrefetchedQuery& Query : ClimbPrefetches)
+	{
+		if (!Query.bIsReady || Query.Kind != EClimbPrefetchQuery::Ledge || FVector::DotProduct(Query.Forward, Forward) <= 0.995f) continue;
+
+		const FVector ToQuery = Query.Location - Location;
+		const double Height = FVector::DotProduct(ToQuery, Up);
+		if (Height < 0.0 || Height > ClosestHeight) continue;
+		if (FVector::VectorPlaneProject(ToQuery, Up).SizeSquared() > FMath::Square(ClimbPrefetchTolerance)) continue;
+
+		Closest = &Query;
+		ClosestHeight = Height;
+	}
+
+	if (Closest != nullptr)
+	{
+		INC_DWORD_STAT(STAT_ClimbPrefetchHits);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ClimbPrefetchMisses);
+	}
+	return Closest;
+}
+
+void UClimbForgeMovementComponent::ClearClimbPrefetches()
+{
+	for (FClimbPrefetchedQuery& Query : ClimbPrefetches)
+	{
+		Query = FClimbPrefetchedQuery();
+	}
+}
+
+void UClimbForgeMovementComponent::UpdateClimbContactSummary()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimbContactSummary);
+	ClimbContactBatch.Assign<FHitResult>(ClimbableSurfacesHits);
+	ClimbContactSummary = ClimbMath::SummarizeContacts(ClimbContactBatch, UpdatedComponent->GetForwardVector(),
+		ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+
+	if (ClimbableSurfacesHits.IsEmpty())
+	{
+		ClimbableSurface.Reset();
+		ClimbableSurfaceComponent.Reset();
+		return;
+	}
+
+	const int32 BaseHitIndex = ClimbContactSummary.BestCandidate != INDEX_NONE ? ClimbContactSummary.BestCandidate : 0;
+	ClimbableSurfaceComponent = ClimbableSurfacesHits[BaseHitIndex].GetComponent();
+	ClimbableSurface.Set(ClimbContactSummary.AverageLocation, ClimbContactSummary.AverageNormal, ClimbableSurfaceComponent.Get());
+}
+
+void UClimbForgeMovementComponent::ExchangeAsyncClimbSweep(const FVector& Start, const FVector& End)
+{
+	UWorld* World = GetWorld();
+
+	// The world only keeps the trace data of this frame and the last one. A sweep issued longer ago, e.g. before a hitch or a frame
+	// in which the climb step did not trace, is gone and is replaced by a sweep that answers right away.
+	if (PendingClimbSweepHandle.IsValid() && !World->IsTraceHandleValid(PendingClimbSweepHandle, false))
+	{
+		PendingClimbSweepHandle.Invalidate();
+	}
+
+	if (PendingClimbSweepHandle.IsValid())
+	{
+		// Not finished yet, e.g. a second trace in the same frame. Keep the hits we have and let it complete.
+		FTraceDatum SweepResult;
+		if (!World->QueryTraceData(PendingClimbSweepHandle, SweepResult)) return;
+
+		ClimbableSurfacesHits = MoveTemp(SweepResult.OutHits);
+	}
+	else
+	{
+		ClimbableSurfacesHits = CapsuleSweepTraceByChannel(Start, End);
+	}
+
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(ClimbCollisionCapsuleRadius, ClimbCollisionCapsuleHalfHeight);
+	PendingClimbSweepHandle = World->AsyncSweepByChannel(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ClimbableSurfaceTraceChannel,
+		CollisionShape, ClimbQueryParams);
+}
+
+FHitResult UClimbForgeMovementComponent::TraceFromEyeHeight(const float TraceDistance, const float TraceStartOffset)
 {
 	const FVector EyeHeightOffset = UpdatedComponent->GetUpVector() * (CharacterOwner->BaseEyeHeight + TraceStartOffset);
 	const FVector Start = UpdatedComponent->GetComponentLocation() + EyeHeightOffset;
 	const FVector End = Start + (UpdatedComponent->GetForwardVector() * TraceDistance);
-	return LineTraceByChannel(Start, End, bShowDebugShape, bShowPersistent);
+	return LineTraceByChannel(Start, End);
 }
 
 bool UClimbForgeMovementComponent::HasReachedTheFloor()
@@ -360,44 +792,79 @@ bool UClimbForgeMovementComponent::HasReachedTheFloor()
 	const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;
 	const FVector End = Start + DownVector;
 
-	TArray<FHitResult> PossibleFloorHits = CapsuleSweepTraceByChannel(Start, End);
+	// Collision with floor will be hit even when actor is about to climb up from floor but then the Z of the velocity will be
+	// either positive (jumping) or 0 (walking, running or other ground locomotion). it is negative only when actor is climbing down.
+	// Checked first as it saves the sweep whenever the actor is not climbing down.
+	if (GetUnrotatedClimbingVelocity().Z >= -10.0f) return false;
+
+	// Climbing down terrain, the height below the capsule answers it without the sweep. The floor has to be within
+	// the bottom half of the capsule at the end of the sweep.
+	const FClimbHeightfield Heightfield = GetClimbHeightfield(ClimbableSurfaceComponent.Get());
+	if (Heightfield.IsValid() && FClimbHeightfield::CanTrace(Start, End))
+	{
+		INC_DWORD_STAT(STAT_ClimbHeightfieldQueries);
+		const FHitResult FloorHit = Heightfield.Trace(Start, End + DownVector * ClimbCollisionCapsuleHalfHeight);
+		return FloorHit.bBlockingHit && FloorHit.ImpactNormal.Z >= UE_THRESH_NORMALS_ARE_PARALLEL;
+	}
+
+	const TArray<FHitResult> PossibleFloorHits = CapsuleSweepTraceByChannel(Start, End);
 
 	if (PossibleFloorHits.IsEmpty()) return false;
 
-	for (const FHitResult& Hit : PossibleFloorHits)
-	{
-		// The hit is a legit floor only when the dot product of the impact normal and the up vector is equal
-		// to cos(1). a and b are parallel when dot(a,b) = a.Size()*b.Size()*cos(1). As the vectors are unit vectors
-		// here dot(a,b) = cos(1) which is what parallel function checks against.
+	// The hit is a legit floor only when the dot product of the impact normal and the up vector is equal
+	// to cos(1). a and b are parallel when dot(a,b) = a.Size()*b.Size()*cos(1). As the vectors are unit vectors
+	// here dot(a,b) = cos(1) which is what parallel function checks against.
+	FloorContactBatch.Assign<FHitResult>(PossibleFloorHits);
+	const ClimbMath::FClimbContactSummary FloorSummary = ClimbMath::SummarizeContacts(FloorContactBatch, UpdatedComponent->GetForwardVector(),
+		ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
 
-		// Collision with floor will be hit even when actor is about to climb up from floor but then the Z of the velocity will be
-		// either positive (jumping) or 0 (walking, running or other ground locomotion). it is negative only when actor is climbing down.
-		const bool bIsLegitFloor = FVector::Parallel(Hit.ImpactNormal, FVector::UpVector)  &&
-			GetUnrotatedClimbingVelocity().Z < -10.0f;
-		
-		if (bIsLegitFloor)
-		{
-			return true;
-		}
-	}
-	
-	return false;
+	return FMath::Max(FloorSummary.MaxUpDot, -FloorSummary.MinUpDot) >= UE_THRESH_NORMALS_ARE_PARALLEL;
 }
 
 bool UClimbForgeMovementComponent::HasReachedTheLedge()
 {
 	if (OwnerActorAnimInstance == nullptr) return false;
 	if (OwnerActorAnimInstance->Montage_IsPlaying(ClimbToTopMontage)) return true;
-	
+
+	// The target is only taken while the climber moves up into the ledge, a target nobody climbs to would be replicated for
+	// as long as the climber hangs below it.
+	if (GetUnrotatedClimbingVelocity().Z <= 10.0f) return false;
+
+	// Most frames there is still wall at eye height. A prefetched trace made at or a bit above this spot tells that without tracing.
+	const FClimbPrefetchedQuery* Prefetch = bPrefetchClimbQueries ? FindLedgePrefetch() : nullptr;
+	if (Prefetch != nullptr && Prefetch->bWallAtEyeHeight) return false;
+
 	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
 	const float TraceDistance = Capsule->GetUnscaledCapsuleRadius() * 2.5f;
+
 	const FHitResult LedgeHit = TraceFromEyeHeight(TraceDistance, 20.0f);
 
 	if (!LedgeHit.bBlockingHit)
 	{
 		const FVector WalkableSurfaceStart = LedgeHit.TraceEnd + UpdatedComponent->GetUpVector()*OwnerColliderCapsuleHalfHeight;
 		const FVector WalkableSurfaceEnd = WalkableSurfaceStart + UpdatedComponent->GetUpVector()*-2.0f*OwnerColliderCapsuleHalfHeight;
-		const FHitResult WalkableSurfaceHit = LineTraceByChannel(WalkableSurfaceStart, WalkableSurfaceEnd);
+
+		// The prefetch already found the top and swept the capsule onto it. Moved by the few units the climber is to its side, its
+		// top is the one the trace from here would hit, as long as it lies within the trace from here.
+		if (Prefetch != nullptr && Prefetch->LedgeTopHit.bBlockingHit)
+		{
+			const FVector Up = UpdatedComponent->GetUpVector();
+			const FVector SideOffset = FVector::VectorPlaneProject(UpdatedComponent->GetComponentLocation() - Prefetch->Location, Up);
+
+			FHitResult WalkableSurfaceHit = Prefetch->LedgeTopHit;
+			WalkableSurfaceHit.Location += SideOffset;
+			WalkableSurfaceHit.ImpactPoint += SideOffset;
+			const double TopHeight = FVector::DotProduct(WalkableSurfaceHit.Location - WalkableSurfaceEnd, Up);
+			if (FMath::IsWithinInclusive(TopHeight, 0.0, 2.0*OwnerColliderCapsuleHalfHeight))
+			{
+				if (Prefetch->bLedgeTopBlocked) return false;
+
+				TakeLedgeTarget(WalkableSurfaceHit);
+				return true;
+			}
+		}
+
+		const FHitResult WalkableSurfaceHit = GroundTraceByChannel(WalkableSurfaceStart, WalkableSurfaceEnd, ClimbableSurfaceComponent.Get());
 
 		if (WalkableSurfaceHit.bBlockingHit && WalkableSurfaceHit.Normal.Z >= GetWalkableFloorZ())
 		{
@@ -414,23 +881,8 @@ bool UClimbForgeMovementComponent::HasReachedTheLedge()
 
 			if (!bCapsuleHit)
 			{
-				ClimbToLedgeTargetLocation = WalkableSurfaceHit.Location;
-				// Check the slope of the ledge. If it is not flat then we have to give the Target location
-				// to the montage via motion warp so that by the end of the animation montage the character is almost at the
-				// target location. If it is not at the exact place then the logic in tick will handle the rest by giving manual velocity and
-				// the system playing the walk animation INSTEAD of teleporting and glitching.
-				const float Dot = FVector::DotProduct(WalkableSurfaceHit.Normal.GetSafeNormal(), UpdatedComponent->GetUpVector());
-				LedgeSurfaceSlopeDegrees = FMath::RadiansToDegrees( FMath::Acos(Dot));
-
-				if (!FMath::IsNearlyZero(LedgeSurfaceSlopeDegrees))
-				{
-					SetMotionWarpTarget("LedgeWarpOffset", ClimbToLedgeTargetLocation);
-					bUsedMotionWarpForLedgeClimb = true;
-				}
-				if (GetUnrotatedClimbingVelocity().Z > 10.0f)
-				{
-					return true;
-				}
+				TakeLedgeTarget(WalkableSurfaceHit);
+				return true;
 			}
 		}
 	} 
@@ -438,27 +890,56 @@ bool UClimbForgeMovementComponent::HasReachedTheLedge()
 	return false;	
 }
 
+void UClimbForgeMovementComponent::TakeLedgeTarget(const FHitResult& WalkableSurfaceHit)
+{
+	ClimbToLedgeTarget.Set(WalkableSurfaceHit.Location, WalkableSurfaceHit.ImpactNormal, WalkableSurfaceHit.GetComponent());
+	// Check the slope of the ledge. If it is not flat then we have to give the Target location
+	// to the montage via motion warp so that by the end of the animation montage the character is almost at the
+	// target location. If it is not at the exact place then the logic in tick will handle the rest by giving manual velocity and
+	// the system playing the walk animation INSTEAD of teleporting and glitching.
+	const float Dot = FVector::DotProduct(WalkableSurfaceHit.Normal.GetSafeNormal(), UpdatedComponent->GetUpVector());
+	LedgeSurfaceSlopeDegrees = FMath::RadiansToDegrees( FMath::Acos(Dot));
+
+	if (!FMath::IsNearlyZero(LedgeSurfaceSlopeDegrees))
+	{
+		SetMotionWarpTarget("LedgeWarpOffset", ClimbToLedgeTarget.GetLocation());
+		bUsedMotionWarpForLedgeClimb = true;
+	}
+}
+
 void UClimbForgeMovementComponent::TryStartVaulting()
 {
 	FVector VaultStartPosition = FVector::ZeroVector;
 	FVector VaultLandPosition = FVector::ZeroVector;
-	if (CanStartVaulting(VaultStartPosition,  VaultLandPosition))
+	EClimbVaultFailReason FailReason = EClimbVaultFailReason::None;
+	if (CanStartVaulting(VaultStartPosition,  VaultLandPosition, FailReason))
 	{
 		//Start Vaulting - motion warp and play montage;
-		SetMotionWarpTarget("VaultStart", VaultStartPosition);
-		SetMotionWarpTarget("VaultLand", VaultLandPosition);
-		StartClimbing();
-		PlayMontage(VaultingMontage);
+		if (StartPredictedAction(EClimbPredictedAction::Vault, EClimbingDirection::Idle, VaultStartPosition, VaultLandPosition))
+		{
+			CLIMB_TELEMETRY(EClimbTelemetryEventType::VaultStart, CharacterOwner);
+			SendPredictedAction(EClimbPredictedAction::Vault, EClimbingDirection::Idle, VaultStartPosition, VaultLandPosition);
+		}
+		else
+		{
+			CLIMB_TELEMETRY(EClimbTelemetryEventType::VaultFail, CharacterOwner, EClimbVaultFailReason::Busy);
+		}
 	}
 	else
 	{
-		Debug::Print(TEXT("Cannot Vault"), FColor::Red, 1);
+		CLIMB_TELEMETRY(EClimbTelemetryEventType::VaultFail, CharacterOwner, FailReason);
+		UE_VLOG(CharacterOwner, LogClimbForgeMovement, Log, TEXT("Cannot vault: %s"), LexToString(FailReason));
 	}
 }
 
-bool UClimbForgeMovementComponent::CanStartVaulting(FVector& VaultStartPosition, FVector& VaultLandPosition)
+bool UClimbForgeMovementComponent::CanStartVaulting(FVector& VaultStartPosition, FVector& VaultLandPosition, EClimbVaultFailReason& OutFailReason)
 {
-	if (IsFalling()) return false;
+	OutFailReason = EClimbVaultFailReason::None;
+	if (IsFalling())
+	{
+		OutFailReason = EClimbVaultFailReason::Falling;
+		return false;
+	}
 
 	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
 	const FVector ForwardVector = UpdatedComponent->GetForwardVector();
@@ -490,12 +971,14 @@ bool UClimbForgeMovementComponent::CanStartVaulting(FVector& VaultStartPosition,
 	if (!ObstacleHit.bBlockingHit)
 	{
 		// No obstacle found to vault over immediately in front.
+		OutFailReason = EClimbVaultFailReason::NoObstacle;
 		return false;
 	}
 	if ( FVector::DistSquared(ObstacleHit.Location, ObstacleHit.TraceStart) < VerticalTraceDepthSquaredHalf )
 	{
 		// If the impact point is closer to the trace start then
 		// the impact is probably a climbable surface instead of a vaulting surface.
+		OutFailReason = EClimbVaultFailReason::ObstacleTooHigh;
 		return false;
 	}
 
@@ -511,18 +994,46 @@ bool UClimbForgeMovementComponent::CanStartVaulting(FVector& VaultStartPosition,
 	FHitResult ObstacleEdgeDetectionHit;
 	bool bObstacleEdgeFound = false;
 
-	for (float Distance = 50.0f; Distance <= MaxVaultLength; Distance += 50.0f)
+	// Distance between subsequent edge detection traces
+	constexpr float EdgeTraceInterval = 50.0f;
+	const int32 NumEdgeTraces = FMath::FloorToInt32(MaxVaultLength / EdgeTraceInterval);
+
+	const FClimbHeightfield ObstacleHeightfield = GetClimbHeightfield(ObstacleHit.GetComponent());
+	if (ObstacleHeightfield.IsValid() && FClimbHeightfield::CanTrace(LandingTraceStart, LandingTraceStart + DownVector))
 	{
-		FVector Start = LandingTraceStart + ForwardVector * Distance;
-		FVector End = Start + (DownVector * VerticalTraceDepth);
-		
-		ObstacleEdgeDetectionHit = LineTraceByChannel(Start, End);		
-		if (!ObstacleEdgeDetectionHit.bBlockingHit)
+		// A terrain obstacle, sample the heights under all edge traces at once. The edge is where the terrain drops below the
+		// reach of the trace.
+		INC_DWORD_STAT(STAT_ClimbHeightfieldQueries);
+		const FVector FirstStart = LandingTraceStart + ForwardVector * EdgeTraceInterval;
+		const FVector LastStart = LandingTraceStart + ForwardVector * (EdgeTraceInterval * NumEdgeTraces);
+		ObstacleHeightfield.SampleHeights(FirstStart, LastStart, NumEdgeTraces, VaultEdgeHeights);
+
+		const int32 EdgeIndex = ClimbMath::FindFirstHeightBelow(VaultEdgeHeights, NumEdgeTraces, LandingTraceStart.Z - VerticalTraceDepth);
+		if (EdgeIndex != INDEX_NONE)
 		{
-			// No ledge beneath — we've reached the end of the ledge
-			ObstacleEdgeLocation = Start;
+			ObstacleEdgeLocation = LandingTraceStart + ForwardVector * (EdgeTraceInterval * (EdgeIndex + 1));
 			bObstacleEdgeFound = true;
-			break;
+		}
+		else
+		{
+			ObstacleEdgeDetectionHit = ObstacleHeightfield.Trace(LastStart, LastStart + DownVector * VerticalTraceDepth);
+		}
+	}
+	else
+	{
+		for (int32 EdgeTrace = 1; EdgeTrace <= NumEdgeTraces; ++EdgeTrace)
+		{
+			FVector Start = LandingTraceStart + ForwardVector * (EdgeTraceInterval * EdgeTrace);
+			FVector End = Start + (DownVector * VerticalTraceDepth);
+			
+			ObstacleEdgeDetectionHit = LineTraceByChannel(Start, End);		
+			if (!ObstacleEdgeDetectionHit.bBlockingHit)
+			{
+				// No ledge beneath — we've reached the end of the ledge
+				ObstacleEdgeLocation = Start;
+				bObstacleEdgeFound = true;
+				break;
+			}
 		}
 	}
 	
@@ -532,7 +1043,7 @@ bool UClimbForgeMovementComponent::CanStartVaulting(FVector& VaultStartPosition,
 		// Find the Ground Z or else vault montage will end mid air.
 		const FVector GroundZTraceStart = ObstacleEdgeLocation + ForwardVector * 30.0f;
 		const FVector GroundZTraceEnd = GroundZTraceStart + (DownVector * VerticalTraceDepth*5.0f);
-		const FHitResult GroundHit = LineTraceByChannel(GroundZTraceStart, GroundZTraceEnd);
+		const FHitResult GroundHit = GroundTraceByChannel(GroundZTraceStart, GroundZTraceEnd, ObstacleHit.GetComponent());
 		
 		if (GroundHit.bBlockingHit)
 		{
@@ -549,6 +1060,7 @@ bool UClimbForgeMovementComponent::CanStartVaulting(FVector& VaultStartPosition,
 		return true;
 	}
 	
+	OutFailReason = EClimbVaultFailReason::NoLanding;
 	return false;
 }
 
@@ -559,13 +1071,58 @@ void UClimbForgeMovementComponent::PhysClimbing(const float DeltaTime, int32 Ite
 		return;
 	}
 
+	// Root motion is extracted for the whole frame, so montage driven climbing keeps stepping with the frame time.
+	if (!bUseFixedClimbStep || HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity())
+	{
+		ResetClimbStepInterpolation();
+		SimulateClimbStep(DeltaTime);
+		NumClimbStepsThisFrame = 1;
+		return;
+	}
+
+	const float StepTime = 1.0f / ClimbSimulationRate;
+	ClimbStepAccumulator += DeltaTime;
+	const int32 NumSteps = FMath::Min(FMath::FloorToInt(ClimbStepAccumulator / StepTime), MaxClimbStepsPerFrame);
+	ClimbStepAccumulator = FMath::Fmod(ClimbStepAccumulator - NumSteps * StepTime, StepTime);
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		// The first step uses the trace from the end of the last tick. Async sweeps only land once per frame.
+		if (Step > 0 && !bUseAsyncClimbTraces)
+		{
+			TraceClimbableSurfaces();
+		}
+
+		PreviousClimbStepTransform = UpdatedComponent->GetComponentTransform();
+		SimulateClimbStep(StepTime);
+		++NumClimbStepsThisFrame;
+
+		// Stopped climbing or started a ledge climb, the rest of the frame belongs to the new mode or montage.
+		if (!IsClimbing() || HasAnimRootMotion()) break;
+	}
+
+	if (IsClimbing())
+	{
+		UpdateClimbStepInterpolation(ClimbStepAccumulator / StepTime);
+	}
+}
+
+void UClimbForgeMovementComponent::SimulateClimbStep(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimbStep);
+
 	// TODO - Process all climbable surfaces info
 	
 	ProcessClimbableSurfaces();
 	// TODO - Check to see if climbing needs to stop
-	if (ShouldStopClimbing() || HasReachedTheFloor())
+	if (ShouldStopClimbing())
 	{
-		StopClimbing();
+		StopClimbing(ClimbableSurfacesHits.IsEmpty() ? EClimbStopReason::NoSurface : EClimbStopReason::UnclimbableSurface);
+	}
+	else
+	if (HasReachedTheFloor())
+	{
+		StopClimbing(EClimbStopReason::ReachedFloor);
 	}
 	
 	RestorePreAdditiveRootMotionVelocity();
@@ -591,13 +1148,19 @@ void UClimbForgeMovementComponent::PhysClimbing(const float DeltaTime, int32 Ite
 		SlideAlongSurface(Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
 	}
 
-	if (HasReachedTheLedge())
+	// Never budgeted: a climber on the wall that skips it climbs on past the lip until it runs out of surface and falls.
+	if (CanInitiateClimbActions() && HasReachedTheLedge())
 	{
-		// Reset the character rotation leaving only the Yaw unaffected. This improves the motion when the character is climbing steep surfaces.
-		const FRotator StandRotation = FRotator(0, UpdatedComponent->GetComponentRotation().Yaw, 0);
-		UpdatedComponent->SetRelativeRotation(StandRotation);
 		//SetMotionWarpTarget("WalkToTargetAfterClimb", WalkToTargetAfterClimb);
-		PlayMontage(ClimbToTopMontage);
+		const FVector LedgeTargetLocation = ClimbToLedgeTarget.GetLocation();
+		if (StartPredictedAction(EClimbPredictedAction::LedgeClimb, EClimbingDirection::Idle, LedgeTargetLocation, FVector::ZeroVector))
+		{
+			SendPredictedAction(EClimbPredictedAction::LedgeClimb, EClimbingDirection::Idle, LedgeTargetLocation, FVector::ZeroVector);
+		}
+		else
+		{
+			ClearLedgeClimb();
+		}
 	}
 
 	if(!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
@@ -609,6 +1172,32 @@ void UClimbForgeMovementComponent::PhysClimbing(const float DeltaTime, int32 Ite
 	SnapToClimbableSurface(DeltaTime);
 }
 
+void UClimbForgeMovementComponent::UpdateClimbStepInterpolation(const float Alpha) const
+{
+	USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh();
+	if (Mesh == nullptr) return;
+
+	FTransform VisualTransform;
+	VisualTransform.Blend(PreviousClimbStepTransform, UpdatedComponent->GetComponentTransform(), Alpha);
+
+	const FTransform MeshRelativeTransform(CharacterOwner->GetBaseRotationOffset(), CharacterOwner->GetBaseTranslationOffset());
+	const FTransform MeshTransform = MeshRelativeTransform * VisualTransform;
+	Mesh->SetWorldLocationAndRotation(MeshTransform.GetLocation(), MeshTransform.GetRotation());
+}
+
+void UClimbForgeMovementComponent::ResetClimbStepInterpolation()
+{
+	if (!bUseFixedClimbStep) return;
+
+	ClimbStepAccumulator = 0.0f;
+	PreviousClimbStepTransform = UpdatedComponent->GetComponentTransform();
+
+	if (USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh())
+	{
+		Mesh->SetRelativeLocationAndRotation(CharacterOwner->GetBaseTranslationOffset(), CharacterOwner->GetBaseRotationOffset());
+	}
+}
+
 void UClimbForgeMovementComponent::ProcessClimbableSurfaces()
 {
 	ClimbableSurfaceLocation = FVector::ZeroVector;
@@ -616,38 +1205,286 @@ void UClimbForgeMovementComponent::ProcessClimbableSurfaces()
 
 	if (ClimbableSurfacesHits.IsEmpty()) return;
 
-	const FVector SweepStart = UpdatedComponent->GetComponentLocation();
-	const FCollisionShape SphereShape = FCollisionShape::MakeSphere(5.0f);
-
 	//Debug::Print(TEXT("ClimbableSurfacesHits:: ")+FString::FromInt(ClimbableSurfacesHits.Num()));
-	
-	for (FHitResult SurfaceHits : ClimbableSurfacesHits)
-	{
-		// TODO - come back to this later.
-		// // Sometimes with overlapping surfaces we can get slightly incorrect normals.
-		// // The sweep is already present in the collision done by overlap thus making the normal(s) point towards the center.
-		// //  This makes the character rotate incorrectly while climbing.
-		// // So doing a sphere sweep to each hit we have from the character location would give us correct straight normals.
-		// const FVector DirectionVector = (SurfaceHits.ImpactPoint - SweepStart).GetSafeNormal();
-		// const FVector End = SweepStart + DirectionVector * 100.0f;// some arbitrary length.
-		//
-		// FHitResult SphereHit;
-		// const bool bHit = GetWorld()->SweepSingleByChannel(SphereHit, SweepStart, End, FQuat::Identity, ClimbableSurfaceTraceChannel,
-		// 	SphereShape, ClimbQueryParams);
-		//
-		// //DrawDebugSphereTraceSingle(GetWorld(), SweepStart, End, 5.0f,EDrawDebugTrace::ForOneFrame, bHit, SphereHit, FColor::Blue, FColor::Red, 25.0f);
-				
-		ClimbableSurfaceLocation += SurfaceHits.ImpactPoint;
-		ClimbableSurfaceNormal += SurfaceHits.ImpactNormal;
-	}
-
-	ClimbableSurfaceLocation /= ClimbableSurfacesHits.Num();
-	ClimbableSurfaceNormal = ClimbableSurfaceNormal.GetSafeNormal();
+
+	// Averaged in the same pass that classified the hits when they were traced.
+	ClimbableSurfaceLocation = ClimbableSurface.GetLocation();
+	// With overlapping surfaces the sweep's normals point towards the capsule center instead of straight out of the surface,
+	// which makes the character rotate incorrectly while climbing.
+	ClimbableSurfaceNormal = RefineClimbableSurfaceNormal(ClimbableSurface.GetNormal());
+
+	// The movement mode change clears the base, so set it again every step. This does nothing if it did not change.
+	// Being based on a movable wall makes the character movement carry the climber along with it, see UpdateBasedMovement.
+	SetBase(ClimbableSurfaceComponent.Get());
 
 	// Debug::Print(TEXT("ClimbableSurfaceLocation:: ")+ ClimbableSurfaceLocation.ToCompactString(), FColor::Red, 1.0f);
 	// Debug::Print(TEXT("ClimbableSurfaceNormal:: ")+ ClimbableSurfaceNormal.ToCompactString(), FColor::Orange, 2.0f);
 }
 
+FVector UClimbForgeMovementComponent::RefineClimbableSurfaceNormal(const FVector& AveragedNormal)
+{
+	// A single contact has no other surface to skew its normal.
+	if (!bRefineClimbNormals || ClimbableSurfacesHits.Num() < 2)
+	{
+		RefinedClimbableSurface.Reset();
+		return AveragedNormal;
+	}
+
+	// Contacts on a single flat face already give its normal.
+	const float MinAgreementDot = FMath::Cos(FMath::DegreesToRadians(ClimbNormalAgreementAngle));
+	const bool bContactsAgree = !ClimbableSurfacesHits.ContainsByPredicate([&AveragedNormal, MinAgreementDot](const FHitResult& Hit)
+	{
+		return FVector::DotProduct(Hit.ImpactNormal, AveragedNormal) < MinAgreementDot;
+	});
+	if (bContactsAgree)
+	{
+		RefinedClimbableSurface.Reset();
+		return AveragedNormal;
+	}
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	if (RefinedClimbableSurface.IsSet() && RefinedClimbableSurfaceComponent == ClimbableSurfaceComponent &&
+		FVector::DistSquared(RefinedClimbableSurface.GetLocation(), Location) <= FMath::Square(ClimbNormalRefinementDistance))
+	{
+		return RefinedClimbableSurface.GetNormal();
+	}
+
+	const FVector IntoSurface = -1.0f * AveragedNormal;
+	const FVector Right = FVector::CrossProduct(UpdatedComponent->GetUpVector(), IntoSurface).GetSafeNormal();
+	if (Right.IsNearlyZero()) return AveragedNormal;
+
+	INC_DWORD_STAT(STAT_ClimbNormalRefinementFans);
+
+	// One trace straight at the surface and four tilted to the sides, so that at a seam or corner every face in front of the
+	// climber is seen once. Line traces report the normal of the face they hit, not a penetration normal.
+	const FVector Up = FVector::CrossProduct(IntoSurface, Right);
+	const float FanAngle = FMath::DegreesToRadians(ClimbNormalFanAngle);
+	const FVector FanDirections[] = { IntoSurface, IntoSurface.RotateAngleAxisRad(FanAngle, Up), IntoSurface.RotateAngleAxisRad(-FanAngle, Up),
+		IntoSurface.RotateAngleAxisRad(FanAngle, Right), IntoSurface.RotateAngleAxisRad(-FanAngle, Right) };
+
+	// Long enough for the tilted traces to still reach the surface a capsule radius behind the contacts.
+	const float SurfaceDistance = FMath::Max(0.0f, FVector::DotProduct(ClimbableSurfaceLocation - Location, IntoSurface));
+	const float TraceLength = (SurfaceDistance + ClimbCollisionCapsuleRadius) / FMath::Cos(FanAngle);
+
+	// The center trace decides which wall this is, without it there is nothing to compare the others against.
+	const FHitResult CenterHit = LineTraceByChannel(Location, Location + FanDirections[0] * TraceLength);
+	if (!CenterHit.bBlockingHit || ClimbMath::IsFloorOrCeilingNormal(CenterHit.ImpactNormal, ClimbMath::FloorDotProductThreshold,
+		ClimbMath::CeilingDotProductThreshold))
+	{
+		return AveragedNormal;
+	}
+
+	// A tilted trace that reaches past the wall, e.g. onto a pillar beside it, would pull the normal off the wall. With no outer hit
+	// left this is the center normal.
+	const float MinFanDot = FMath::Cos(FMath::DegreesToRadians(ClimbNormalMaxFanDeviation));
+	FVector NormalSum = CenterHit.ImpactNormal;
+	for (int32 Index = 1; Index < UE_ARRAY_COUNT(FanDirections); ++Index)
+	{
+		const FHitResult FanHit = LineTraceByChannel(Location, Location + FanDirections[Index] * TraceLength);
+		if (FanHit.bBlockingHit && FVector::DotProduct(FanHit.ImpactNormal, CenterHit.ImpactNormal) >= MinFanDot &&
+			!ClimbMath::IsFloorOrCeilingNormal(FanHit.ImpactNormal, ClimbMath::FloorDotProductThreshold,
+				ClimbMath::CeilingDotProductThreshold))
+		{
+			NormalSum += FanHit.ImpactNormal;
+		}
+	}
+
+	const FVector RefinedNormal = NormalSum.GetSafeNormal();
+
+	RefinedClimbableSurface.Set(Location, RefinedNormal, ClimbableSurfaceComponent.Get());
+	RefinedClimbableSurfaceComponent = ClimbableSurfaceComponent;
+	return RefinedNormal;
+}
+
+FVector UClimbForgeMovementComponent::GetLimbAnchor(const EClimbLimb Limb) const
+{
+	const bool bIsHand = Limb == EClimbLimb::LeftHand || Limb == EClimbLimb::RightHand;
+	const bool bIsLeft = Limb == EClimbLimb::LeftHand || Limb == EClimbLimb::LeftFoot;
+
+	const float Height = bIsHand ? HandTargetHeight : FootTargetHeight;
+	const float Spread = (bIsHand ? HandTargetSpread : FootTargetSpread) * (bIsLeft ? -1.0f : 1.0f);
+
+	return UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetUpVector() * Height + UpdatedComponent->GetRightVector() * Spread;
+}
+
+void UClimbForgeMovementComponent::UpdateLimbTargets()
+{
+	if (ClimbableSurfaceNormal.IsNearlyZero()) return;
+
+	// Holds on a moving component ride along with it, so they are resolved before checking which limbs strayed.
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ClimbMovingSurfaceFollow);
+		for (uint8 Index = 0; Index < static_cast<uint8>(EClimbLimb::MAX); ++Index)
+		{
+			if (!LimbHolds[Index].IsBased()) continue;
+			LimbTargets[Index].Location = LimbHolds[Index].GetLocation();
+			LimbTargets[Index].Normal = LimbHolds[Index].GetNormal();
+		}
+	}
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	// The probes issued with the last sweep. A limb whose probe is still in flight waits for it instead of probing again.
+	for (uint8 Index = 0; Index < static_cast<uint8>(EClimbLimb::MAX); ++Index)
+	{
+		FTraceHandle& Handle = LimbProbeHandles[Index];
+		if (Handle.IsValid() && !World->IsTraceHandleValid(Handle, false))
+		{
+			Handle.Invalidate();
+		}
+
+		FTraceDatum ProbeResult;
+		if (Handle.IsValid() && World->QueryTraceData(Handle, ProbeResult))
+		{
+			Handle.Invalidate();
+			ApplyLimbProbe(static_cast<EClimbLimb>(Index),
+				ProbeResult.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; }));
+		}
+	}
+
+	// All the limbs share the wall found by the climb sweep, so every probe can end just behind it.
+	const FVector ProbeDirection = -1.0f*ClimbableSurfaceNormal;
+	const float WallDistance = FVector::DotProduct(ClimbableSurfaceLocation - UpdatedComponent->GetComponentLocation(), ProbeDirection);
+	const float ProbeLength = FMath::Max(0.0f, WallDistance) + LimbProbeDepth;
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EClimbLimb::MAX); ++Index)
+	{
+		if (LimbProbeHandles[Index].IsValid()) continue;
+
+		const EClimbLimb Limb = static_cast<EClimbLimb>(Index);
+		const FClimbLimbTarget& Target = LimbTargets[Index];
+		if (Target.bIsValid)
+		{
+			// Only the distance along the wall counts, moving towards or away from the wall does not lift a limb.
+			const FVector Offset = FVector::VectorPlaneProject(GetLimbAnchor(Limb) - Target.Location, ClimbableSurfaceNormal);
+			if (Offset.SizeSquared() < FMath::Square(LimbStrideThreshold)) continue;
+		}
+		else
+		if (Now < LimbProbeRetryTime[Index])
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_ClimbLimbProbes);
+		const FVector Start = GetLimbAnchor(Limb);
+		LimbProbeHandles[Index] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start + ProbeDirection * ProbeLength,
+			ClimbableSurfaceTraceChannel, ClimbQueryParams);
+	}
+}
+
+void UClimbForgeMovementComponent::ApplyLimbProbe(const EClimbLimb Limb, const FHitResult* LimbHit)
+{
+	const uint8 Index = static_cast<uint8>(Limb);
+	FClimbLimbTarget& Target = LimbTargets[Index];
+	FClimbSurfacePoint& Hold = LimbHolds[Index];
+	if (LimbHit == nullptr)
+	{
+		// Nothing to hold on to. The limb is unplanted so the rig blends it out instead of pinning it to empty space.
+		Target = FClimbLimbTarget();
+		Hold.Reset();
+		LimbProbeMisses[Index] = FMath::Min<uint8>(LimbProbeMisses[Index] + 1, 4);
+		LimbProbeRetryTime[Index] = GetWorld()->GetTimeSeconds() + LimbMissRetryInterval * LimbProbeMisses[Index];
+		return;
+	}
+
+	LimbProbeMisses[Index] = 0;
+	Target.bIsValid = true;
+	Target.Location = LimbHit->ImpactPoint;
+	Target.Normal = LimbHit->ImpactNormal;
+	Hold.Set(Target.Location, Target.Normal, LimbHit->GetComponent());
+}
+
+void UClimbForgeMovementComponent::ProjectLimbTargetsOntoSurface()
+{
+	if (ClimbableSurfaceNormal.IsNearlyZero()) return;
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EClimbLimb::MAX); ++Index)
+	{
+		const FVector Anchor = GetLimbAnchor(static_cast<EClimbLimb>(Index));
+		const float DistanceFromSurface = FVector::DotProduct(Anchor - ClimbableSurfaceLocation, ClimbableSurfaceNormal);
+
+		FClimbLimbTarget& Target = LimbTargets[Index];
+		Target.bIsValid = true;
+		Target.Location = Anchor - ClimbableSurfaceNormal * DistanceFromSurface;
+		Target.Normal = ClimbableSurfaceNormal;
+	}
+}
+
+void UClimbForgeMovementComponent::SmoothReplicatedClimbState(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SimulatedClimbSmoothing);
+
+	if (!ReplicatedClimbableSurface.IsSet())
+	{
+		ClimbableSurfaceLocation = FVector::ZeroVector;
+		ClimbableSurfaceNormal = FVector::ZeroVector;
+		ClearLimbTargets();
+		return;
+	}
+
+	const FVector TargetLocation = ReplicatedClimbableSurface.GetLocation();
+	const FVector TargetNormal = ReplicatedClimbableSurface.GetNormal();
+
+	// Snap onto the first surface, easing in from a zero normal would swing the character around.
+	if (ClimbableSurfaceNormal.IsZero() || SimulatedClimbSmoothingSpeed <= 0.0f)
+	{
+		ClimbableSurfaceLocation = TargetLocation;
+		ClimbableSurfaceNormal = TargetNormal;
+	}
+	else
+	{
+		ClimbableSurfaceLocation = FMath::VInterpTo(ClimbableSurfaceLocation, TargetLocation, DeltaTime, SimulatedClimbSmoothingSpeed);
+		ClimbableSurfaceNormal = FMath::VInterpTo(ClimbableSurfaceNormal, TargetNormal, DeltaTime, SimulatedClimbSmoothingSpeed).GetSafeNormal();
+	}
+
+	if (bGenerateLimbTargets && IsClimbing())
+	{
+		ProjectLimbTargetsOntoSurface();
+	}
+}
+
+void UClimbForgeMovementComponent::ClearLimbTargets()
+{
+	for (FClimbLimbTarget& Target : LimbTargets)
+	{
+		Target = FClimbLimbTarget();
+	}
+	for (FClimbSurfacePoint& Hold : LimbHolds)
+	{
+		Hold.Reset();
+	}
+	for (uint8 Index = 0; Index < static_cast<uint8>(EClimbLimb::MAX); ++Index)
+	{
+		LimbProbeHandles[Index].Invalidate();
+		LimbProbeMisses[Index] = 0;
+		LimbProbeRetryTime[Index] = 0.0;
+	}
+}
+
+void UClimbForgeMovementComponent::RecordClimbStateToVisualLog() const
+{
+#if ENABLE_VISUAL_LOG
+	if (!FVisualLogger::IsRecording()) return;
+	if (!IsClimbing() && !IsHanging() && ClimbableSurfacesHits.IsEmpty()) return;
+
+	UE_VLOG(CharacterOwner, LogClimbForgeMovement, Log, TEXT("Mode %s, %d surface hits, normal %s, dash %s, ledge target %s"),
+		IsClimbing() ? TEXT("Climbing") : IsHanging() ? TEXT("Hanging") : *GetMovementName(), ClimbableSurfacesHits.Num(),
+		*ClimbableSurfaceNormal.ToCompactString(), *UEnum::GetValueAsString(ActiveClimbDashDirection), *GetClimbToLedgeTargetLocation().ToCompactString());
+
+	for (const FHitResult& Hit : ClimbableSurfacesHits)
+	{
+		UE_VLOG_LOCATION(CharacterOwner, LogClimbForgeMovement, Verbose, Hit.ImpactPoint, 3.0f, Hit.bBlockingHit ? FColor::Red : FColor::Yellow, TEXT(""));
+	}
+
+	if (IsClimbing())
+	{
+		UE_VLOG_ARROW(CharacterOwner, LogClimbForgeMovement, Log, ClimbableSurfaceLocation, ClimbableSurfaceLocation + ClimbableSurfaceNormal * 50.0f,
+			FColor::Cyan, TEXT("Surface normal"));
+	}
+#endif
+}
+
 FQuat UClimbForgeMovementComponent::GetClimbRotation(const float DeltaTime) const
 {
 	const FQuat CurrentQuat = UpdatedComponent->GetComponentQuat();
@@ -659,7 +1496,7 @@ FQuat UClimbForgeMovementComponent::GetClimbRotation(const float DeltaTime) cons
 	}
 
 	// as the target needs to be the climbable surface and not it's normal.
-	const FQuat TargetQuat = FRotationMatrix::MakeFromX(-1.0f*ClimbableSurfaceNormal).ToQuat();
+	const FQuat TargetQuat = ClimbMath::GetSurfaceFacingRotation(ClimbableSurfaceNormal);
 	const float RotationSpeed = 5.0f * FMath::Max(1, Velocity.Length() / MaxClimbSpeed);
 	return FMath::QInterpTo(CurrentQuat,TargetQuat,DeltaTime,5.0f);	
 }
@@ -674,16 +1511,8 @@ inline void UClimbForgeMovementComponent::SnapToClimbableSurface(const float Del
 		OwnerActorAnimInstance->GetCurrentActiveMontage() == ClimbDashUpMontage ||
 		OwnerActorAnimInstance->GetCurrentActiveMontage() == ClimbDashDownMontage)) return;
 	
-	const FVector CurrentLocation = UpdatedComponent->GetComponentLocation();
-	const FVector ForwardVector = UpdatedComponent->GetForwardVector();
-
-	// Get the distance between the actor and the climbable surface location and project it onto the plane of the
-	// actor's forward vector. This is the vector facing the surface and having length equal to the distance
-	// between actor and the surface.
-	const FVector ProjectedVector = (ClimbableSurfaceLocation - CurrentLocation).ProjectOnTo(ForwardVector);
-
-	// The Vector (distance and direction) required for us to snap the actor to the climbable surface.
-	const FVector SnapVector = -1.0f*ClimbableSurfaceNormal*ProjectedVector.Length();
+	const FVector SnapVector = ClimbMath::GetSnapVector(UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetForwardVector(),
+		ClimbableSurfaceLocation, ClimbableSurfaceNormal);
 
 	UpdatedComponent->MoveComponent(SnapVector*DeltaTime*MaxClimbSpeed, UpdatedComponent->GetComponentQuat(), true);	
 	
@@ -695,40 +1524,81 @@ inline void UClimbForgeMovementComponent::SnapToClimbableSurface(const float Del
 
 }
 
-void UClimbForgeMovementComponent::PlayMontage(const TObjectPtr<UAnimMontage>& MontageToPlay) const
+bool UClimbForgeMovementComponent::PlayMontage(const TObjectPtr<UAnimMontage>& MontageToPlay) const
 {
-	if(MontageToPlay == nullptr) return;
-	if (OwnerActorAnimInstance == nullptr) return;
-	if (OwnerActorAnimInstance->IsAnyMontagePlaying()) return;
+	if(MontageToPlay == nullptr) return false;
+	if (OwnerActorAnimInstance == nullptr) return false;
+	if (OwnerActorAnimInstance->IsAnyMontagePlaying()) return false;
 
-	OwnerActorAnimInstance->Montage_Play(MontageToPlay);
+	UE_VLOG(CharacterOwner, LogClimbForgeMovement, Log, TEXT("Play montage %s"), *MontageToPlay->GetName());
+	return OwnerActorAnimInstance->Montage_Play(MontageToPlay) > 0.0f;
 }
 
 void UClimbForgeMovementComponent::MontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
+	UE_VLOG(CharacterOwner, LogClimbForgeMovement, Log, TEXT("Montage %s ended, interrupted %d"), *GetNameSafe(Montage), bInterrupted);
+
+	const bool bIsClimbDashMontage = Montage == ClimbDashUpMontage || Montage == ClimbDashDownMontage || Montage == ClimbDashLeftMontage ||
+		Montage == ClimbDashRightMontage;
+
+	// Cleanup runs however the montage ended, an interrupted montage must not leave its warp target, offset or mode behind.
+	if (Montage == ClimbToTopMontage && bUsedMotionWarpForLedgeClimb)
+	{
+		bUsedMotionWarpForLedgeClimb = false;
+		if (const AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner))
+		{		
+			Owner->GetMotionWarpingComponent()->RemoveWarpTarget("LedgeWarpOffset");					
+		}
+	}
+
+	// ResetClimbState clears the location before the blend out of the montage it stopped arrives, there is nothing to restore then.
+	if ((Montage == ClimbDashLeftMontage || Montage == ClimbDashRightMontage) && !CharacterLocationBeforeDashMontage.IsZero())
+	{
+		FVector CurrentLocation = UpdatedComponent->GetComponentLocation();
+		if (CurrentLocation.Z != CharacterLocationBeforeDashMontage.Z)
+		{
+			CurrentLocation.Z = CharacterLocationBeforeDashMontage.Z;
+			UpdatedComponent->SetWorldLocation(CurrentLocation);
+		}
+	}
+
+	if (bIsClimbDashMontage)
+	{
+		ActiveClimbDashDirection = EClimbingDirection::Idle;
+	}
+
+	// An interrupted montage was cut short by ResetClimbState, a rejected prediction or another montage. Whoever did that owns
+	// the next transition, so only the follow ups are skipped. A vault or ledge climb that did not finish still leaves the
+	// climbing mode it ran in, falling finds the floor again.
+	if (bInterrupted)
+	{
+		if (Montage == ClimbToTopMontage)
+		{
+			ClearLedgeClimb();
+		}
+		if ((Montage == VaultingMontage || Montage == ClimbToTopMontage) && IsClimbing())
+		{
+			SetMovementMode(MOVE_Falling);
+		}
+		return;
+	}
+
 	if (Montage == IdleToClimbMontage || Montage == ClimbDownFromLegdeMontage)
 	{
+		CLIMB_TELEMETRY(EClimbTelemetryEventType::ClimbStart, CharacterOwner);
 		StartClimbing();
 		StopMovementImmediately();
 	}
 	else
 	if (Montage == ClimbToTopMontage)
 	{
-		if (bUsedMotionWarpForLedgeClimb)
-		{
-			bUsedMotionWarpForLedgeClimb = false;
-			if (const AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner))
-			{		
-				Owner->GetMotionWarpingComponent()->RemoveWarpTarget("LedgeWarpOffset");					
-			}
-		}
-
 		// Check if the target location is in front or behind the character's current location.
 		// Proceed with the logic only if the target location is in front.
 		FVector CurrentLocation = UpdatedComponent->GetComponentLocation();
 		const FVector ForwardVector = UpdatedComponent->GetForwardVector();		
 		// Get the direction from character to target location.
-		const FVector ToTarget = (ClimbToLedgeTargetLocation - CurrentLocation).GetSafeNormal();
+		const FVector LedgeTargetLocation = ClimbToLedgeTarget.GetLocation();
+		const FVector ToTarget = (LedgeTargetLocation - CurrentLocation).GetSafeNormal();
 		const float DotValue = FVector::DotProduct(ForwardVector, ToTarget);
 
 		// The target is in front.
@@ -737,10 +1607,14 @@ void UClimbForgeMovementComponent::MontageEnded(UAnimMontage* Montage, bool bInt
 			// Adjust the character Z here as in the Tick logic we consider only X and Y components
 			// as Ground Speed in anim instance is 2D.
 			const float ZOffset = CurrentLocation.Z - GetActorFeetLocation().Z;
-			CurrentLocation.Z = ZOffset + ClimbToLedgeTargetLocation.Z;
+			CurrentLocation.Z = ZOffset + LedgeTargetLocation.Z;
 			UpdatedComponent->SetWorldLocation(CurrentLocation);
 			bMoveToTargetAfterClimb = true;
 		}
+		else
+		{
+			ClearLedgeClimb();
+		}
 		SetMovementMode(MOVE_Walking);	
 	}
 	else
@@ -748,16 +1622,26 @@ void UClimbForgeMovementComponent::MontageEnded(UAnimMontage* Montage, bool bInt
 	{
 		SetMovementMode(MOVE_Walking);	
 	}
-	else
-	if (Montage == ClimbDashLeftMontage || Montage == ClimbDashRightMontage)
+}
+
+bool UClimbForgeMovementComponent::IsLedgeClimbInProgress() const
+{
+	return bMoveToTargetAfterClimb || (OwnerActorAnimInstance != nullptr && OwnerActorAnimInstance->Montage_IsPlaying(ClimbToTopMontage));
+}
+
+void UClimbForgeMovementComponent::ClearLedgeClimb()
+{
+	if (bUsedMotionWarpForLedgeClimb)
 	{
-		FVector CurrentLocation = UpdatedComponent->GetComponentLocation();
-		if (CurrentLocation.Z != CharacterLocationBeforeDashMontage.Z)
+		bUsedMotionWarpForLedgeClimb = false;
+		if (const AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner))
 		{
-			CurrentLocation.Z = CharacterLocationBeforeDashMontage.Z;
-			UpdatedComponent->SetWorldLocation(CurrentLocation);
+			Owner->GetMotionWarpingComponent()->RemoveWarpTarget("LedgeWarpOffset");
 		}
 	}
+	bMoveToTargetAfterClimb = false;
+	ClimbToLedgeTarget.Reset();
+	LedgeSurfaceSlopeDegrees = 0.0f;
 }
 
 void UClimbForgeMovementComponent::SetMotionWarpTarget(const FName& InWarpTargetName, const FVector& InTargetLocation)
@@ -765,79 +1649,169 @@ void UClimbForgeMovementComponent::SetMotionWarpTarget(const FName& InWarpTarget
 	if (const AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner))
 	{		
 		Owner->GetMotionWarpingComponent()->AddOrUpdateWarpTargetFromLocation(InWarpTargetName, InTargetLocation);
+		UE_VLOG_LOCATION(CharacterOwner, LogClimbForgeMovement, Log, InTargetLocation, 10.0f, FColor::Magenta, TEXT("%s"), *InWarpTargetName.ToString());
 	}	
 }
 
-void UClimbForgeMovementComponent::RequestClimbDash()
-{	
-	const FVector UnrotatedLastInputVector = UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), GetLastInputVector());
-		
-	const float VerticalAxisDotResult = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), UpdatedComponent->GetUpVector());
-	
-	const FVector UnrotatedRightVector = UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), UpdatedComponent->GetRightVector());
-	const float HorizontalAxisDotResult = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), UnrotatedRightVector);
-	
-	if (VerticalAxisDotResult > 0.9f)
+void UClimbForgeMovementComponent::ResetClimbState()
+{
+	if (OwnerActorAnimInstance != nullptr)
 	{
-		TryPerformClimbDash(EClimbingDirection::Up);
+		OwnerActorAnimInstance->StopAllMontages(0.0f);
 	}
-	else
-	if (VerticalAxisDotResult < -0.9f)
+
+	// Leaving the wall restores the capsule and rotation and tells the owner to drop its climbing input and camera.
+	if (IsClimbing() || IsHanging())
 	{
-		TryPerformClimbDash(EClimbingDirection::Down);
+		SetMovementMode(MOVE_Falling);
 	}
-	else
-	if (HorizontalAxisDotResult > 0.9f)
+	CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(OwnerColliderCapsuleHalfHeight);
+	bOrientRotationToMovement = true;
+
+	ClimbableSurfacesHits.Reset();
+	ClimbContactSummary = ClimbMath::FClimbContactSummary();
+	ClearClimbPrefetches();
+	ClimbableSurfaceLocation = FVector::ZeroVector;
+	ClimbableSurfaceNormal = FVector::ZeroVector;
+	ClimbableSurface.Reset();
+	ClimbableSurfaceComponent.Reset();
+	RefinedClimbableSurface.Reset();
+	RefinedClimbableSurfaceComponent.Reset();
+	ReplicatedClimbableSurface.Reset();
+	CharacterLocationBeforeDashMontage = FVector::ZeroVector;
+
+	bMoveToTargetAfterClimb = false;
+	ClimbToLedgeTarget.Reset();
+	LedgeSurfaceSlopeDegrees = 0.0f;
+	bUsedMotionWarpForLedgeClimb = false;
+	bClimbRequestDeferred = false;
+	ActiveClimbDashDirection = EClimbingDirection::Idle;
+	PendingPredictedAction = FClimbPredictedActionRequest();
+	PendingClimbSweepHandle.Invalidate();
+
+	LedgeSegment = FClimbLedgeSegment();
+	LedgeSegmentDistance = 0.0f;
+	BlockedLedgeSegmentEnd = 0;
+	ClearLimbTargets();
+
+	if (const AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner))
 	{
-		TryPerformClimbDash(EClimbingDirection::Right);
+		for (const FName& WarpTargetName : ClimbWarpTargetNames)
+		{
+			Owner->GetMotionWarpingComponent()->RemoveWarpTarget(WarpTargetName);
+		}
 	}
-	else
-	if (HorizontalAxisDotResult < -0.9f)
+
+	StopMovementImmediately();
+}
+
+FClimbReplicatedState UClimbForgeMovementComponent::BuildReplicatedClimbState() const
+{
+	FClimbReplicatedState State;
+	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
+
+	if (IsClimbing() || IsHanging())
 	{
-		TryPerformClimbDash(EClimbingDirection::Left);
+		State.SetSurface(ClimbableSurfaceNormal, ClimbableSurfaceLocation, PawnLocation);
 	}
-	else
+	if (ClimbToLedgeTarget.IsSet() && IsLedgeClimbInProgress())
 	{
-		Debug::Print(TEXT("Invalid direction for dash"), FColor::Red, 1);		
+		State.SetLedgeTarget(ClimbToLedgeTarget.GetLocation(), PawnLocation);
 	}
+	State.SetDashDirection(ActiveClimbDashDirection);
+	State.SetMoveToTargetAfterClimb(bMoveToTargetAfterClimb);
+	return State;
 }
 
-void UClimbForgeMovementComponent::TryPerformClimbDash(const EClimbingDirection ClimbingDirection)
+void UClimbForgeMovementComponent::ApplyReplicatedClimbState(const FClimbReplicatedState& InState)
 {
-	FVector DashHitPoint = FVector::ZeroVector;
-	
-	if (CanStartClimbDash(ClimbingDirection, DashHitPoint))
-	{
-		SetMotionWarpTarget(FName("HopHitPoint"), DashHitPoint);
-		switch (ClimbingDirection)
-		{
-			case EClimbingDirection::Up:
-			{
-				PlayMontage(ClimbDashUpMontage);
-			}
-			break;
+	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
 
-			case EClimbingDirection::Down:
-			{
-				PlayMontage(ClimbDashDownMontage);
-			}
-			break;
-
-			case EClimbingDirection::Left:
-			{
-				PlayMontage(ClimbDashLeftMontage);
-			}
-			break;
+	// Applied over the next ticks by SmoothReplicatedClimbState, on the proxy's replicated movement base if it has one.
+	const FVector SurfaceNormal = InState.GetSurfaceNormal();
+	if (SurfaceNormal.IsZero())
+	{
+		ReplicatedClimbableSurface.Reset();
+	}
+	else
+	{
+		ReplicatedClimbableSurface.Set(InState.GetSurfaceLocation(PawnLocation), SurfaceNormal, CharacterOwner->GetMovementBase());
+	}
+	// The proxy replicates its movement base, which is the component the ledge target was found on.
+	if (InState.HasLedgeTarget())
+	{
+		ClimbToLedgeTarget.Set(InState.GetLedgeTarget(PawnLocation), FVector::UpVector, CharacterOwner->GetMovementBase());
+	}
+	else
+	{
+		ClimbToLedgeTarget.Reset();
+	}
+	ActiveClimbDashDirection = InState.GetDashDirection();
+	bMoveToTargetAfterClimb = InState.ShouldMoveToTargetAfterClimb();
+}
 
-			case EClimbingDirection::Right:
-			{				
-				PlayMontage(ClimbDashRightMontage);
-			}
-			break;
+void UClimbForgeMovementComponent::RequestClimbDash()
+{	
+	const FVector UnrotatedLastInputVector = UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), GetLastInputVector());
 		
-		default: ;
+	const float VerticalAxisDotResult = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), UpdatedComponent->GetUpVector());
+	
+	const FVector UnrotatedRightVector = UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), UpdatedComponent->GetRightVector());
+	const float HorizontalAxisDotResult = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), UnrotatedRightVector);
+	
+	const EClimbingDirection DashDirection = ClimbMath::ResolveDashDirection(VerticalAxisDotResult, HorizontalAxisDotResult);
+	if (DashDirection != EClimbingDirection::Idle)
+	{
+		TryPerformClimbDash(DashDirection);
+	}
+	else
+	{
+		CLIMB_TELEMETRY(EClimbTelemetryEventType::DashFail, CharacterOwner, EClimbDashFailReason::InvalidDirection);
+	}
+}
+
+void UClimbForgeMovementComponent::TryPerformClimbDash(const EClimbingDirection ClimbingDirection)
+{
+	FVector DashHitPoint = FVector::ZeroVector;
+	
+	if (CanStartClimbDash(ClimbingDirection, DashHitPoint))
+	{
+		if (StartPredictedAction(EClimbPredictedAction::Dash, ClimbingDirection, DashHitPoint, FVector::ZeroVector))
+		{
+			CLIMB_TELEMETRY(EClimbTelemetryEventType::DashStart, CharacterOwner, EClimbDashFailReason::None, ClimbingDirection);
+			SendPredictedAction(EClimbPredictedAction::Dash, ClimbingDirection, DashHitPoint, FVector::ZeroVector);
+		}
+		else
+		{
+			CLIMB_TELEMETRY(EClimbTelemetryEventType::DashFail, CharacterOwner, EClimbDashFailReason::Busy, ClimbingDirection);
 		}
 	}
+	else
+	{
+		CLIMB_TELEMETRY(EClimbTelemetryEventType::DashFail, CharacterOwner, EClimbDashFailReason::NoTarget, ClimbingDirection);
+		UE_VLOG(CharacterOwner, LogClimbForgeMovement, Log, TEXT("Cannot dash %s: no target"), *UEnum::GetValueAsString(ClimbingDirection));
+	}
+}
+
+UAnimMontage* UClimbForgeMovementComponent::GetClimbDashMontage(const EClimbingDirection ClimbingDirection) const
+{
+	switch (ClimbingDirection)
+	{
+		case EClimbingDirection::Up:
+			return ClimbDashUpMontage;
+
+		case EClimbingDirection::Down:
+			return ClimbDashDownMontage;
+
+		case EClimbingDirection::Left:
+			return ClimbDashLeftMontage;
+
+		case EClimbingDirection::Right:
+			return ClimbDashRightMontage;
+		
+		default:
+			return nullptr;
+	}
 }
 
 bool UClimbForgeMovementComponent::CanStartClimbDash(const EClimbingDirection ClimbingDirection, FVector& OutDashHitPoint)
@@ -909,6 +1883,488 @@ bool UClimbForgeMovementComponent::CanStartClimbDash(const EClimbingDirection Cl
 
 #pragma endregion
 
+#pragma region ClimbPrediction
+
+bool UClimbForgeMovementComponent::CanInitiateClimbActions() const
+{
+	return CharacterOwner->GetLocalRole() != ROLE_Authority || CharacterOwner->GetRemoteRole() != ROLE_AutonomousProxy;
+}
+
+bool UClimbForgeMovementComponent::StartPredictedAction(const EClimbPredictedAction Action, const EClimbingDirection Direction,
+	const FVector& WarpTarget, const FVector& SecondaryWarpTarget)
+{
+	SetPredictedActionWarpTargets(Action, WarpTarget, SecondaryWarpTarget);
+
+	switch (Action)
+	{
+		case EClimbPredictedAction::Dash:
+		{
+			if (!PlayMontage(GetClimbDashMontage(Direction))) return false;
+			ActiveClimbDashDirection = Direction;
+			return true;
+		}
+
+		case EClimbPredictedAction::Vault:
+		{
+			// The vault runs in the climbing mode, which is only entered once the montage is known to play.
+			if (!PlayMontage(VaultingMontage)) return false;
+			StartClimbing();
+			return true;
+		}
+
+		case EClimbPredictedAction::LedgeClimb:
+		{
+			// Reset the character rotation leaving only the Yaw unaffected. This improves the motion when the character is climbing steep surfaces.
+			const FRotator StandRotation = FRotator(0, UpdatedComponent->GetComponentRotation().Yaw, 0);
+			UpdatedComponent->SetRelativeRotation(StandRotation);
+			return PlayMontage(ClimbToTopMontage);
+		}
+
+		// The climbing mode itself is entered once the montage ends, see MontageEnded.
+		case EClimbPredictedAction::ClimbStart:
+		{
+			return PlayMontage(IdleToClimbMontage);
+		}
+
+		case EClimbPredictedAction::ClimbDown:
+		{
+			return PlayMontage(ClimbDownFromLegdeMontage);
+		}
+
+		case EClimbPredictedAction::Hang:
+		{
+			return StartHanging();
+		}
+
+		case EClimbPredictedAction::LetGo:
+		{
+			if (!IsClimbing() && !IsHanging()) return false;
+			StopClimbing(EClimbStopReason::LetGo);
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+void UClimbForgeMovementComponent::SetPredictedActionWarpTargets(const EClimbPredictedAction Action, const FVector& WarpTarget,
+	const FVector& SecondaryWarpTarget)
+{
+	switch (Action)
+	{
+		case EClimbPredictedAction::Dash:
+		{
+			SetMotionWarpTarget(FName("HopHitPoint"), WarpTarget);
+		}
+		break;
+
+		case EClimbPredictedAction::Vault:
+		{
+			SetMotionWarpTarget("VaultStart", WarpTarget);
+			SetMotionWarpTarget("VaultLand", SecondaryWarpTarget);
+		}
+		break;
+
+		case EClimbPredictedAction::LedgeClimb:
+		{
+			ClimbToLedgeTarget.SetLocation(WarpTarget);
+			if (bUsedMotionWarpForLedgeClimb)
+			{
+				SetMotionWarpTarget("LedgeWarpOffset", WarpTarget);
+			}
+		}
+		break;
+
+		default: ;
+	}
+}
+
+void UClimbForgeMovementComponent::SendPredictedAction(const EClimbPredictedAction Action, const EClimbingDirection Direction,
+	const FVector& WarpTarget, const FVector& SecondaryWarpTarget)
+{
+	if (CharacterOwner->GetLocalRole() != ROLE_AutonomousProxy) return;
+
+	AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner);
+	if (Owner == nullptr) return;
+
+	PendingPredictedAction.RequestId = ++NextPredictedActionId;
+	PendingPredictedAction.Action = Action;
+	PendingPredictedAction.Direction = Direction;
+	PendingPredictedAction.WarpTarget = WarpTarget;
+	PendingPredictedAction.SecondaryWarpTarget = SecondaryWarpTarget;
+
+	Owner->ServerRequestClimbAction(PendingPredictedAction);
+}
+
+void UClimbForgeMovementComponent::HandlePredictedActionRequest(const FClimbPredictedActionRequest& Request)
+{
+	AClimbForgeCharacter* Owner = Cast<AClimbForgeCharacter>(CharacterOwner);
+	if (Owner == nullptr) return;
+
+	// Run the same queries the client ran, against the server's world.
+	FVector ServerWarpTarget = FVector::ZeroVector;
+	FVector ServerSecondaryWarpTarget = FVector::ZeroVector;
+	bool bIsPossible = false;
+	switch (Request.Action)
+	{
+		case EClimbPredictedAction::Dash:
+		{
+			bIsPossible = IsClimbing() && CanStartClimbDash(Request.Direction, ServerWarpTarget);
+		}
+		break;
+
+		case EClimbPredictedAction::Vault:
+		{
+			EClimbVaultFailReason FailReason;
+			bIsPossible = CanStartVaulting(ServerWarpTarget, ServerSecondaryWarpTarget, FailReason);
+		}
+		break;
+
+		case EClimbPredictedAction::LedgeClimb:
+		{
+			bIsPossible = IsClimbing() && HasReachedTheLedge();
+			ServerWarpTarget = ClimbToLedgeTarget.GetLocation();
+		}
+		break;
+
+		case EClimbPredictedAction::ClimbStart:
+		{
+			bIsPossible = CanStartClimbing();
+		}
+		break;
+
+		case EClimbPredictedAction::ClimbDown:
+		{
+			bIsPossible = CanStartClimbingDown();
+		}
+		break;
+
+		// The ledge queries run when the hang starts, an unreachable ledge fails StartPredictedAction below.
+		case EClimbPredictedAction::Hang:
+		case EClimbPredictedAction::LetGo:
+		{
+			bIsPossible = true;
+		}
+		break;
+
+		default: ;
+	}
+
+	FClimbPredictedActionResult Result;
+	Result.RequestId = Request.RequestId;
+
+	if (bIsPossible)
+	{
+		// Within tolerance the client's targets are kept so both sides play exactly the same motion.
+		const float ToleranceSquared = FMath::Square(PredictedActionWarpTolerance);
+		const bool bMatches = FVector::DistSquared(ServerWarpTarget, Request.WarpTarget) <= ToleranceSquared &&
+			FVector::DistSquared(ServerSecondaryWarpTarget, Request.SecondaryWarpTarget) <= ToleranceSquared;
+
+		Result.bCorrected = !bMatches;
+		Result.WarpTarget = bMatches ? FVector(Request.WarpTarget) : ServerWarpTarget;
+		Result.SecondaryWarpTarget = bMatches ? FVector(Request.SecondaryWarpTarget) : ServerSecondaryWarpTarget;
+
+		// The server's own montage or mode change can still fail, the client must not keep an action the server never ran.
+		Result.bAccepted = StartPredictedAction(Request.Action, Request.Direction, Result.WarpTarget, Result.SecondaryWarpTarget);
+		if (!Result.bAccepted && Request.Action == EClimbPredictedAction::LedgeClimb)
+		{
+			ClearLedgeClimb();
+		}
+	}
+
+	Owner->ClientResolveClimbAction(Result);
+}
+
+void UClimbForgeMovementComponent::HandlePredictedActionResult(const FClimbPredictedActionResult& Result)
+{
+	// An answer to an older request, the client has moved on since.
+	if (PendingPredictedAction.Action == EClimbPredictedAction::None || Result.RequestId != PendingPredictedAction.RequestId) return;
+
+	const FClimbPredictedActionRequest Request = PendingPredictedAction;
+	PendingPredictedAction = FClimbPredictedActionRequest();
+
+	if (Result.bAccepted)
+	{
+		// Warping picks up the new targets for the rest of the montage, no movement snapshot is needed.
+		if (Result.bCorrected)
+		{
+			SetPredictedActionWarpTargets(Request.Action, Result.WarpTarget, Result.SecondaryWarpTarget);
+		}
+		return;
+	}
+
+	// Rejected. Stopping the montage interrupts it, which skips its follow up transitions (see MontageEnded).
+	UMotionWarpingComponent* MotionWarpingComponent = CastChecked<AClimbForgeCharacter>(CharacterOwner)->GetMotionWarpingComponent();
+	switch (Request.Action)
+	{
+		case EClimbPredictedAction::Dash:
+		{
+			if (OwnerActorAnimInstance != nullptr)
+			{
+				OwnerActorAnimInstance->Montage_Stop(0.2f, GetClimbDashMontage(Request.Direction));
+			}
+			MotionWarpingComponent->RemoveWarpTarget(FName("HopHitPoint"));
+			ActiveClimbDashDirection = EClimbingDirection::Idle;
+		}
+		break;
+
+		case EClimbPredictedAction::Vault:
+		{
+			if (OwnerActorAnimInstance != nullptr && OwnerActorAnimInstance->Montage_IsPlaying(VaultingMontage))
+			{
+				OwnerActorAnimInstance->Montage_Stop(0.2f, VaultingMontage);
+				SetMovementMode(MOVE_Walking);
+			}
+			MotionWarpingComponent->RemoveWarpTarget(FName("VaultStart"));
+			MotionWarpingComponent->RemoveWarpTarget(FName("VaultLand"));
+		}
+		break;
+
+		case EClimbPredictedAction::LedgeClimb:
+		{
+			if (OwnerActorAnimInstance != nullptr)
+			{
+				OwnerActorAnimInstance->Montage_Stop(0.2f, ClimbToTopMontage);
+			}
+			ClearLedgeClimb();
+		}
+		break;
+
+		// Stopping the entry montage keeps the climb from starting. Should it have ended already, fall off the wall the server never
+		// climbed.
+		case EClimbPredictedAction::ClimbStart:
+		case EClimbPredictedAction::ClimbDown:
+		{
+			if (OwnerActorAnimInstance != nullptr)
+			{
+				OwnerActorAnimInstance->Montage_Stop(0.2f, Request.Action == EClimbPredictedAction::ClimbStart ? IdleToClimbMontage :
+					ClimbDownFromLegdeMontage);
+			}
+			if (IsClimbing())
+			{
+				SetMovementMode(MOVE_Falling);
+			}
+		}
+		break;
+
+		case EClimbPredictedAction::Hang:
+		{
+			if (IsHanging())
+			{
+				SetMovementMode(MOVE_Falling);
+			}
+		}
+		break;
+
+		// The client already let go of a wall the server says it was not on, both agree now.
+		default: ;
+	}
+}
+
+#pragma endregion
+
+#pragma region HangCore
+
+bool UClimbForgeMovementComponent::CanStartHanging(FClimbLedgeSegment& OutSegment, float& OutSegmentDistance)
+{
+	const FHitResult WallHit = TraceFromEyeHeight(HangEntryTraceDistance);
+	if (!WallHit.bBlockingHit) return false;
+
+	// The hands need to be able to reach the ledge top from where the character is right now.
+	const float ExpectedTopZ = UpdatedComponent->GetComponentLocation().Z + HangHeightBelowLedge;
+	if (!ExtractLedgeSegment(WallHit.ImpactPoint, WallHit.ImpactNormal, ExpectedTopZ, HangLedgeGrabTolerance, OutSegment)) return false;
+
+	OutSegmentDistance = FMath::Clamp(OutSegment.GetDistanceOf(WallHit.ImpactPoint), 0.0f, OutSegment.GetLength());
+	return true;
+}
+
+void UClimbForgeMovementComponent::TryStartHanging()
+{
+	if (StartPredictedAction(EClimbPredictedAction::Hang, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector))
+	{
+		SendPredictedAction(EClimbPredictedAction::Hang, EClimbingDirection::Idle, FVector::ZeroVector, FVector::ZeroVector);
+	}
+}
+
+bool UClimbForgeMovementComponent::StartHanging()
+{
+	FClimbLedgeSegment Segment;
+	float SegmentDistance = 0.0f;
+	if (!CanStartHanging(Segment, SegmentDistance)) return false;
+
+	LedgeSegment = Segment;
+	LedgeSegmentDistance = SegmentDistance;
+	BlockedLedgeSegmentEnd = 0;
+
+	// The climbing input is built from the surface normal so keep it pointing away from the ledge wall.
+	ClimbableSurfaceNormal = LedgeSegment.WallNormal;
+	ClimbableSurfaceLocation = LedgeSegment.GetPointAt(LedgeSegmentDistance);
+
+	SetMovementMode(MOVE_Custom, MOVE_Hanging);
+	StopMovementImmediately();
+	return true;
+}
+
+bool UClimbForgeMovementComponent::FindLedgeTop(const FVector& WallFacePoint, const FVector& WallNormal, const float ExpectedTopZ,
+	const float Tolerance, FHitResult& OutTopHit)
+{
+	FVector Start = WallFacePoint - WallNormal * HangLedgeInset;
+	Start.Z = ExpectedTopZ + Tolerance;
+	const FVector End = FVector(Start.X, Start.Y, ExpectedTopZ - Tolerance);
+
+	OutTopHit = LineTraceByChannel(Start, End);
+
+	// Starting inside geometry means the wall keeps going up, so this is not a ledge.
+	if (!OutTopHit.bBlockingHit || OutTopHit.bStartPenetrating) return false;
+	return OutTopHit.ImpactNormal.Z >= GetWalkableFloorZ();
+}
+
+bool UClimbForgeMovementComponent::ExtractLedgeSegment(const FVector& WallFacePoint, const FVector& WallNormal, const float ExpectedTopZ,
+	const float Tolerance, FClimbLedgeSegment& OutSegment)
+{
+	const FVector HorizontalNormal = WallNormal.GetSafeNormal2D();
+	if (HorizontalNormal.IsNearlyZero()) return false;
+
+	FHitResult TopHit;
+	if (!FindLedgeTop(WallFacePoint, HorizontalNormal, ExpectedTopZ, Tolerance, TopHit)) return false;
+	const float TopZ = TopHit.ImpactPoint.Z;
+
+	const FVector AlongLedge = FVector::CrossProduct(HorizontalNormal, FVector::UpVector).GetSafeNormal();
+	const FVector Base = FVector(WallFacePoint.X, WallFacePoint.Y, TopZ);
+
+	// Walk to each side of the grab point until either the ledge top changes height or the wall face below it bends away.
+	// All of this is paid once per segment, shimmying along it afterwards does not touch the world.
+	float Reach[2] = { 0.0f, 0.0f };
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		const float Sign = Side == 0 ? -1.0f : 1.0f;
+		for (float Distance = HangLedgeProbeStep; Distance <= MaxLedgeSegmentHalfLength; Distance += HangLedgeProbeStep)
+		{
+			const FVector Sample = Base + AlongLedge * Sign * Distance;
+
+			FHitResult SampleTopHit;
+			if (!FindLedgeTop(Sample, HorizontalNormal, TopZ, HangLedgeHeightTolerance, SampleTopHit)) break;
+
+			const FVector FaceTraceStart = Sample + HorizontalNormal * HangWallOffset - FVector::UpVector * HangLedgeInset;
+			const FVector FaceTraceEnd = FaceTraceStart - HorizontalNormal * (HangWallOffset + HangLedgeInset);
+			const FHitResult FaceHit = LineTraceByChannel(FaceTraceStart, FaceTraceEnd);
+			if (!FaceHit.bBlockingHit || FVector::DotProduct(FaceHit.ImpactNormal.GetSafeNormal2D(), HorizontalNormal) < 0.95f) break;
+
+			Reach[Side] = Distance;
+		}
+	}
+
+	OutSegment.Start = Base - AlongLedge * Reach[0];
+	OutSegment.End = Base + AlongLedge * Reach[1];
+	OutSegment.Direction = AlongLedge;
+	OutSegment.WallNormal = HorizontalNormal;
+	OutSegment.SetBase(TopHit.GetComponent());
+	return true;
+}
+
+bool UClimbForgeMovementComponent::ExtendLedgeSegment(const int8 SegmentEnd)
+{
+	const FVector EndPoint = SegmentEnd < 0 ? LedgeSegment.Start : LedgeSegment.End;
+	const FVector ProbePoint = EndPoint + LedgeSegment.Direction * SegmentEnd * HangLedgeProbeStep;
+
+	// Find the wall face again, it may have turned slightly at the end of the segment.
+	const FVector FaceTraceStart = ProbePoint + LedgeSegment.WallNormal * HangWallOffset - FVector::UpVector * HangLedgeInset;
+	const FVector FaceTraceEnd = FaceTraceStart - LedgeSegment.WallNormal * (HangWallOffset + HangLedgeInset);
+	const FHitResult FaceHit = LineTraceByChannel(FaceTraceStart, FaceTraceEnd);
+	if (!FaceHit.bBlockingHit) return false;
+
+	FClimbLedgeSegment NextSegment;
+	const FVector FacePoint = FaceHit.ImpactPoint + FVector::UpVector * HangLedgeInset;
+	if (!ExtractLedgeSegment(FacePoint, FaceHit.ImpactNormal, EndPoint.Z, HangLedgeHeightTolerance, NextSegment)) return false;
+
+	LedgeSegment = NextSegment;
+	LedgeSegmentDistance = FMath::Clamp(LedgeSegment.GetDistanceOf(EndPoint), 0.0f, LedgeSegment.GetLength());
+	ClimbableSurfaceNormal = LedgeSegment.WallNormal;
+	return true;
+}
+
+FVector UClimbForgeMovementComponent::GetHangLocation(const float SegmentDistance) const
+{
+	return LedgeSegment.GetPointAt(SegmentDistance) + LedgeSegment.WallNormal * HangWallOffset - FVector::UpVector * HangHeightBelowLedge;
+}
+
+void UClimbForgeMovementComponent::PhysHanging(const float DeltaTime, int32 Iterations)
+{
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	if (!LedgeSegment.IsValid())
+	{
+		StopClimbing(EClimbStopReason::LostLedge);
+		return;
+	}
+
+	// The based movement already carried the character along with a moving ledge, move the segment the same way.
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ClimbMovingSurfaceFollow);
+		if (LedgeSegment.FollowBase())
+		{
+			ClimbableSurfaceNormal = LedgeSegment.WallNormal;
+		}
+	}
+	SetBase(LedgeSegment.Base.Get());
+
+	RestorePreAdditiveRootMotionVelocity();
+
+	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		// Only the input along the ledge moves the character, everything else is fixed by the segment.
+		const float InputAlongLedge = FVector::DotProduct(Acceleration.GetSafeNormal(), LedgeSegment.Direction);
+		Velocity = LedgeSegment.Direction * InputAlongLedge * MaxHangShimmySpeed;
+	}
+
+	ApplyRootMotionToVelocity(DeltaTime);
+
+	float NewDistance = LedgeSegmentDistance + FVector::DotProduct(Velocity, LedgeSegment.Direction) * DeltaTime;
+	const int8 ReachedEnd = NewDistance < 0.0f ? -1 : (NewDistance > LedgeSegment.GetLength() ? 1 : 0);
+
+	if (ReachedEnd == 0)
+	{
+		BlockedLedgeSegmentEnd = 0;
+	}
+	else
+	if (ReachedEnd != BlockedLedgeSegmentEnd)
+	{
+		// The only place where hanging probes the world again.
+		const float Overshoot = ReachedEnd < 0 ? NewDistance : NewDistance - LedgeSegment.GetLength();
+		if (ExtendLedgeSegment(ReachedEnd))
+		{
+			NewDistance = FMath::Clamp(LedgeSegmentDistance + Overshoot, 0.0f, LedgeSegment.GetLength());
+		}
+		else
+		{
+			BlockedLedgeSegmentEnd = ReachedEnd;
+		}
+	}
+	NewDistance = FMath::Clamp(NewDistance, 0.0f, LedgeSegment.GetLength());
+
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	const FVector Delta = GetHangLocation(NewDistance) - OldLocation;
+	const FQuat TargetQuat = FRotationMatrix::MakeFromX(-1.0f*LedgeSegment.WallNormal).ToQuat();
+	FHitResult Hit(1.f);
+
+	SafeMoveUpdatedComponent(Delta, FMath::QInterpTo(UpdatedComponent->GetComponentQuat(), TargetQuat, DeltaTime, 10.0f), true, Hit);
+
+	// Something is in the way along the ledge, stay where the move stopped.
+	LedgeSegmentDistance = Hit.Time < 1.f ? LedgeSegment.GetDistanceOf(UpdatedComponent->GetComponentLocation()) : NewDistance;
+	ClimbableSurfaceLocation = LedgeSegment.GetPointAt(LedgeSegmentDistance);
+
+	if(!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime;
+	}
+}
+
+#pragma endregion
+
 
 
 
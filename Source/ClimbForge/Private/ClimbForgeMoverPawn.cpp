@@ -0,0 +1,182 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbForgeMoverPawn.h"
+
+#include "ClimbMath.h"
+#include "ClimbMoverComponent.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputActionValue.h"
+#include "MoverDataModelTypes.h"
+#include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/SpringArmComponent.h"
+
+AClimbForgeMoverPawn::AClimbForgeMoverPawn(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	CapsuleComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CollisionCylinder"));
+	CapsuleComponent->InitCapsuleSize(35.f, 90.0f);
+	CapsuleComponent->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+	RootComponent = CapsuleComponent;
+
+	Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("CharacterMesh0"));
+	Mesh->SetupAttachment(CapsuleComponent);
+	Mesh->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+
+	// Mover moves the capsule on its own simulation and replicates its sync state instead of the actor movement.
+	MoverComponent = CreateDefaultSubobject<UClimbMoverComponent>(TEXT("MoverComponent"));
+	bReplicates = true;
+	SetReplicatingMovement(false);
+
+	// Don't rotate when the controller rotates. Let that just affect the camera.
+	bUseControllerRotationPitch = false;
+	bUseControllerRotationYaw = false;
+	bUseControllerRotationRoll = false;
+
+	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	CameraBoom->SetupAttachment(RootComponent);
+	CameraBoom->TargetArmLength = 400.0f;
+	CameraBoom->bUsePawnControlRotation = true;
+
+	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
+	FollowCamera->bUsePawnControlRotation = false;
+}
+
+void AClimbForgeMoverPawn::RequestClimb()
+{
+	// Like UClimbForgeMovementComponent::ToggleClimbing, an obstacle that can't be climbed is vaulted.
+	PendingClimbInputs.bWantsToClimb = true;
+	PendingClimbInputs.bWantsToVault = true;
+}
+
+void AClimbForgeMoverPawn::RequestVault()
+{
+	PendingClimbInputs.bWantsToVault = true;
+}
+
+void AClimbForgeMoverPawn::RequestLetGo()
+{
+	PendingClimbInputs.bWantsToLetGo = true;
+}
+
+void AClimbForgeMoverPawn::RequestClimbDash(const EClimbingDirection Direction)
+{
+	PendingClimbInputs.DashDirection = Direction;
+}
+
+void AClimbForgeMoverPawn::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	if (DefaultMappingContext != nullptr)
+	{
+		AddInputMappingContext(DefaultMappingContext, 0);
+	}
+	if (ClimbingMappingContext != nullptr)
+	{
+		AddInputMappingContext(ClimbingMappingContext, 1);
+	}
+}
+
+void AClimbForgeMoverPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent))
+	{
+		// The stick is read as a walk direction or as climbing input depending on the mode, see ProduceInput.
+		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AClimbForgeMoverPawn::Move);
+		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Completed, this, &AClimbForgeMoverPawn::MoveCompleted);
+		EnhancedInputComponent->BindAction(ClimbMoveAction, ETriggerEvent::Triggered, this, &AClimbForgeMoverPawn::Move);
+		EnhancedInputComponent->BindAction(ClimbMoveAction, ETriggerEvent::Completed, this, &AClimbForgeMoverPawn::MoveCompleted);
+		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AClimbForgeMoverPawn::Look);
+		EnhancedInputComponent->BindAction(ClimbAction, ETriggerEvent::Started, this, &AClimbForgeMoverPawn::ClimbStarted);
+		EnhancedInputComponent->BindAction(ClimbHopAction, ETriggerEvent::Started, this, &AClimbForgeMoverPawn::ClimbHopStarted);
+	}
+}
+
+void AClimbForgeMoverPawn::ProduceInput_Implementation(int32 SimTimeMs, FMoverInputCmdContext& InputCmdResult)
+{
+	FCharacterDefaultInputs& CharacterInputs = InputCmdResult.InputCollection.FindOrAddMutableDataByType<FCharacterDefaultInputs>();
+	FClimbMoverInputs& ClimbInputs = InputCmdResult.InputCollection.FindOrAddMutableDataByType<FClimbMoverInputs>();
+	ClimbInputs = PendingClimbInputs;
+	PendingClimbInputs = FClimbMoverInputs();
+
+	if (Controller == nullptr)
+	{
+		CharacterInputs.SetMoveInput(EMoveInputType::DirectionalIntent, FVector::ZeroVector);
+		CharacterInputs.OrientationIntent = FVector::ZeroVector;
+		return;
+	}
+
+	CharacterInputs.ControlRotation = Controller->GetControlRotation();
+
+	// UClimbingMode reads the raw stick, X along the wall to the right and Y up it.
+	if (MoverComponent->IsClimbing())
+	{
+		CharacterInputs.SetMoveInput(EMoveInputType::DirectionalIntent, FVector(MoveStick.X, MoveStick.Y, 0.0f));
+		CharacterInputs.OrientationIntent = FVector::ZeroVector;
+		return;
+	}
+
+	// Walk relative to the camera and turn towards the walk direction.
+	const FRotator YawRotation(0.0f, CharacterInputs.ControlRotation.Yaw, 0.0f);
+	const FVector MoveDirection = YawRotation.RotateVector(FVector(MoveStick.Y, MoveStick.X, 0.0f)).GetClampedToMaxSize(1.0f);
+	CharacterInputs.SetMoveInput(EMoveInputType::DirectionalIntent, MoveDirection);
+	CharacterInputs.OrientationIntent = MoveDirection.GetSafeNormal();
+}
+
+void AClimbForgeMoverPawn::Move(const FInputActionValue& Value)
+{
+	MoveStick = Value.Get<FVector2D>();
+}
+
+void AClimbForgeMoverPawn::MoveCompleted(const FInputActionValue& Value)
+{
+	MoveStick = FVector2D::ZeroVector;
+}
+
+void AClimbForgeMoverPawn::Look(const FInputActionValue& Value)
+{
+	const FVector2D LookAxisVector = Value.Get<FVector2D>();
+	AddControllerYawInput(LookAxisVector.X);
+	AddControllerPitchInput(LookAxisVector.Y);
+}
+
+void AClimbForgeMoverPawn::ClimbStarted(const FInputActionValue& Value)
+{
+	// Pressing climb while on a wall lets go of it.
+	if (MoverComponent->IsClimbing())
+	{
+		RequestLetGo();
+	}
+	else
+	{
+		RequestClimb();
+	}
+}
+
+void AClimbForgeMoverPawn::ClimbHopStarted(const FInputActionValue& Value)
+{
+	if (!MoverComponent->IsClimbing()) return;
+
+	// The same direction UClimbForgeMovementComponent::RequestClimbDash resolves from the climbing input.
+	const FVector2D Direction = MoveStick.GetSafeNormal();
+	RequestClimbDash(ClimbMath::ResolveDashDirection(Direction.Y, Direction.X));
+}
+
+void AClimbForgeMoverPawn::AddInputMappingContext(const UInputMappingContext* InContext, const int32 InPriority)
+{
+	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+		{
+			Subsystem->AddMappingContext(InContext, InPriority);
+		}
+	}
+}
@@ -0,0 +1,81 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbHeightfield.h"
+
+#include "LandscapeHeightfieldCollisionComponent.h"
+#include "LandscapeProxy.h"
+
+FClimbHeightfield::FClimbHeightfield(UPrimitiveComponent* InComponent)
+{
+	const ULandscapeHeightfieldCollisionComponent* Collision = Cast<ULandscapeHeightfieldCollisionComponent>(InComponent);
+	if (Collision == nullptr) return;
+
+	Landscape = Collision->GetLandscapeProxy();
+	Component = InComponent;
+	if (Landscape != nullptr)
+	{
+		SampleSpacing = FMath::Max(1.0f, static_cast<float>(Landscape->GetActorScale3D().X));
+	}
+}
+
+bool FClimbHeightfield::CanTrace(const FVector& Start, const FVector& End)
+{
+	return (End - Start).GetSafeNormal().Z <= -UE_THRESH_NORMALS_ARE_PARALLEL;
+}
+
+TOptional<float> FClimbHeightfield::GetHeight(const FVector& Location) const
+{
+	if (Landscape == nullptr) return TOptional<float>();
+	return Landscape->GetHeightAtLocation(Location);
+}
+
+FVector FClimbHeightfield::GetNormal(const FVector& Location) const
+{
+	const TOptional<float> Left = GetHeight(Location - FVector(SampleSpacing, 0.0f, 0.0f));
+	const TOptional<float> Right = GetHeight(Location + FVector(SampleSpacing, 0.0f, 0.0f));
+	const TOptional<float> Back = GetHeight(Location - FVector(0.0f, SampleSpacing, 0.0f));
+	const TOptional<float> Front = GetHeight(Location + FVector(0.0f, SampleSpacing, 0.0f));
+	if (!Left.IsSet() || !Right.IsSet() || !Back.IsSet() || !Front.IsSet()) return FVector::UpVector;
+
+	// Central differences, the normal of the surface z = h(x, y) is (-dh/dx, -dh/dy, 1).
+	return FVector(Left.GetValue() - Right.GetValue(), Back.GetValue() - Front.GetValue(), 2.0f * SampleSpacing).GetSafeNormal();
+}
+
+FHitResult FClimbHeightfield::Trace(const FVector& Start, const FVector& End) const
+{
+	FHitResult Hit(Start, End);
+
+	// Heightfields are one sided, a line that starts below the terrain does not hit it either.
+	const TOptional<float> Height = GetHeight(Start);
+	if (!Height.IsSet() || Height.GetValue() > Start.Z || Height.GetValue() < End.Z) return Hit;
+
+	Hit.bBlockingHit = true;
+	Hit.Location = Hit.ImpactPoint = FVector(Start.X, Start.Y, Height.GetValue());
+	Hit.Normal = Hit.ImpactNormal = GetNormal(Hit.Location);
+	Hit.Distance = Start.Z - Height.GetValue();
+	Hit.Time = Hit.Distance / (Start.Z - End.Z);
+	// Filled in like a traced hit, so GetComponent and GetActor work on it too.
+	Hit.Component = Component;
+	Hit.HitObjectHandle = FActorInstanceHandle(Component->GetOwner());
+	return Hit;
+}
+
+void FClimbHeightfield::SampleHeights(const FVector& Start, const FVector& End, const int32 NumSamples,
+	TArray<float, TAlignedHeapAllocator<16>>& OutHeights) const
+{
+	OutHeights.SetNumUninitialized(Align(NumSamples, 4), EAllowShrinking::No);
+
+	const FVector Step = NumSamples > 1 ? (End - Start) / (NumSamples - 1) : FVector::ZeroVector;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const TOptional<float> Height = GetHeight(Start + Step * Index);
+		OutHeights[Index] = Height.Get(-UE_BIG_NUMBER);
+	}
+
+	for (int32 Index = NumSamples; Index < OutHeights.Num(); ++Index)
+	{
+		OutHeights[Index] = UE_BIG_NUMBER;
+	}
+}
@@ -0,0 +1,27 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbMoverComponent.h"
+
+#include "ClimbingMode.h"
+#include "ClimbWalkingMode.h"
+#include "MoverTypes.h"
+#include "DefaultMovementSet/Modes/FallingMode.h"
+#include "DefaultMovementSet/Modes/FlyingMode.h"
+
+UClimbMoverComponent::UClimbMoverComponent(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	// The modes are subobjects of the component, which is what Mover requires of them.
+	MovementModes.Add(DefaultModeNames::Walking, CreateDefaultSubobject<UClimbWalkingMode>(TEXT("WalkingMode")));
+	MovementModes.Add(DefaultModeNames::Falling, CreateDefaultSubobject<UFallingMode>(TEXT("FallingMode")));
+	MovementModes.Add(DefaultModeNames::Flying, CreateDefaultSubobject<UFlyingMode>(TEXT("FlyingMode")));
+	MovementModes.Add(ClimbModeNames::Climbing, CreateDefaultSubobject<UClimbingMode>(TEXT("ClimbingMode")));
+	StartingMovementMode = DefaultModeNames::Falling;
+}
+
+bool UClimbMoverComponent::IsClimbing() const
+{
+	return GetMovementModeName() == ClimbModeNames::Climbing;
+}
@@ -0,0 +1,31 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbMoverInputs.h"
+
+FMoverDataStructBase* FClimbMoverInputs::Clone() const
+{
+	return new FClimbMoverInputs(*this);
+}
+
+bool FClimbMoverInputs::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Super::NetSerialize(Ar, Map, bOutSuccess);
+
+	Ar.SerializeBits(&bWantsToClimb, 1);
+	Ar.SerializeBits(&bWantsToVault, 1);
+	Ar.SerializeBits(&bWantsToLetGo, 1);
+	Ar << DashDirection;
+
+	bOutSuccess = true;
+	return true;
+}
+
+void FClimbMoverInputs::ToString(FAnsiStringBuilderBase& Out) const
+{
+	Super::ToString(Out);
+
+	Out.Appendf("bWantsToClimb: %i | bWantsToVault: %i | bWantsToLetGo: %i | DashDirection: %i\n", bWantsToClimb, bWantsToVault, bWantsToLetGo,
+		static_cast<int32>(DashDirection));
+}
@@ -0,0 +1,240 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbMoverLibrary.h"
+
+#include "ClimbForgeStats.h"
+#include "ClimbMoverSettings.h"
+#include "ClimbTraversalLayeredMove.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Mover Contacts Sweep"), STAT_ClimbMoverContactsSweep, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Mover Contact Summary"), STAT_ClimbMoverContactSummary, STATGROUP_ClimbForge);
+
+namespace
+{
+	FCollisionQueryParams MakeClimbQueryParams(const UPrimitiveComponent& UpdatedPrimitive)
+	{
+		return FCollisionQueryParams(SCENE_QUERY_STAT(ClimbMover), false, UpdatedPrimitive.GetOwner());
+	}
+
+	// The pawn's capsule, or the climb capsule if the pawn has some other shape.
+	FCollisionShape GetPawnShape(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings)
+	{
+		if (const UCapsuleComponent* Capsule = Cast<UCapsuleComponent>(&UpdatedPrimitive))
+		{
+			return FCollisionShape::MakeCapsule(Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight());
+		}
+		return FCollisionShape::MakeCapsule(Settings.ClimbCollisionCapsuleRadius, Settings.ClimbCollisionCapsuleHalfHeight);
+	}
+}
+
+bool UClimbMoverLibrary::CanStartClimbing(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+	const FQuat& Orientation, FClimbMoverScratch& Scratch)
+{
+	FClimbMoverSurface Surface;
+	if (!FindClimbableSurface(UpdatedPrimitive, Settings, Location, Orientation, Scratch, Surface)) return false;
+	if (Surface.AngleInDegrees >= Settings.MinimumClimbableAngleInDegrees) return false;
+
+	// Like UClimbForgeMovementComponent::CanStartClimbing, small ledges give contacts too so there has to be surface at eye height.
+	constexpr float BaseLength = 80.0f;
+	const float SteepnessMultiplier = 1.0f + (1.0f - Surface.Steepness) * 5.0f;
+	const FVector EyeStart = Location + Orientation.GetUpVector() * Settings.ClimbEyeHeight;
+	const FVector EyeEnd = EyeStart + Orientation.GetForwardVector() * BaseLength * SteepnessMultiplier;
+	return LineTrace(UpdatedPrimitive, Settings, EyeStart, EyeEnd).bBlockingHit;
+}
+
+bool UClimbMoverLibrary::FindClimbDash(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+	const FQuat& Orientation, const EClimbingDirection Direction, FVector& OutTarget)
+{
+	const FVector Up = Orientation.GetUpVector();
+	const FVector Right = Orientation.GetRightVector();
+	const FVector EyeLocation = Location + Up * (Settings.ClimbEyeHeight + Settings.ClimbDashEyeHeightTraceOffset);
+
+	const auto TraceForward = [&](const FVector& Start)
+	{
+		return LineTrace(UpdatedPrimitive, Settings, Start, Start + Orientation.GetForwardVector() * Settings.ClimbDashTraceLength);
+	};
+
+	// The same traces as UClimbForgeMovementComponent::CanStartClimbDash: there has to be wall at eye height and where the dash ends.
+	FHitResult DashHit;
+	FHitResult EdgeHit;
+	switch (Direction)
+	{
+		case EClimbingDirection::Up:
+			DashHit = TraceForward(EyeLocation);
+			EdgeHit = TraceForward(Location + Up * (Settings.ClimbEyeHeight + Settings.ClimbDashEdgeTraceOffset));
+			break;
+
+		case EClimbingDirection::Down:
+			DashHit = EdgeHit = TraceForward(Location + Up * (Settings.ClimbEyeHeight - 2.0f * Settings.ClimbDashEdgeTraceOffset));
+			break;
+
+		case EClimbingDirection::Left:
+			DashHit = TraceForward(EyeLocation);
+			EdgeHit = TraceForward(EyeLocation - Right * Settings.ClimbDashEdgeTraceOffset);
+			break;
+
+		case EClimbingDirection::Right:
+			DashHit = TraceForward(EyeLocation);
+			EdgeHit = TraceForward(EyeLocation + Right * Settings.ClimbDashEdgeTraceOffset);
+			break;
+
+		default:
+			return false;
+	}
+
+	if (!DashHit.bBlockingHit || !EdgeHit.bBlockingHit) return false;
+
+	// The dash ends with the climber's eye trace on the point that was found, a capsule radius off the wall.
+	const float CapsuleRadius = GetPawnShape(UpdatedPrimitive, Settings).GetCapsuleRadius();
+	OutTarget = EdgeHit.ImpactPoint + EdgeHit.ImpactNormal * CapsuleRadius - (EyeLocation - Location);
+	return true;
+}
+
+bool UClimbMoverLibrary::FindVault(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+	const FQuat& Orientation, const float SpeedRatio, FVector& OutControl, FVector& OutTarget)
+{
+	const FVector Forward = Orientation.GetForwardVector();
+	const FVector Up = Orientation.GetUpVector();
+
+	// The same traces as UClimbForgeMovementComponent::CanStartVaulting.
+	constexpr float TraceHeightAboveChar = 100.0f;
+	constexpr float VerticalTraceDepth = 100.0f;
+	constexpr float EdgeTraceInterval = 50.0f;
+	constexpr float MaxVaultLength = 300.0f;
+
+	const float InitialTraceDistance = FMath::Lerp(Settings.MinimumVaultTraceDistance, Settings.MaximumVaultTraceDistance, SpeedRatio);
+
+	const FVector ObstacleTraceStart = Location + Up * TraceHeightAboveChar + Forward * InitialTraceDistance;
+	const FHitResult ObstacleHit = LineTrace(UpdatedPrimitive, Settings, ObstacleTraceStart, ObstacleTraceStart - Up * VerticalTraceDepth);
+
+	// Nothing to vault over, or so close to the trace start that it is a wall to climb instead.
+	if (!ObstacleHit.bBlockingHit || ObstacleHit.Distance < VerticalTraceDepth * UE_INV_SQRT_2) return false;
+
+	const FVector LandingTraceStart = ObstacleHit.ImpactPoint + Up * 20.0f;
+	FVector LandLocation = FVector::ZeroVector;
+	FVector EdgeLocation = LandingTraceStart + Forward * MaxVaultLength;
+	for (float Distance = EdgeTraceInterval; Distance <= MaxVaultLength; Distance += EdgeTraceInterval)
+	{
+		const FVector Start = LandingTraceStart + Forward * Distance;
+		const FHitResult EdgeHit = LineTrace(UpdatedPrimitive, Settings, Start, Start - Up * VerticalTraceDepth);
+		if (!EdgeHit.bBlockingHit)
+		{
+			// Past the end of the obstacle, land on the ground behind it.
+			const FVector GroundStart = Start + Forward * 30.0f;
+			const FHitResult GroundHit = LineTrace(UpdatedPrimitive, Settings, GroundStart, GroundStart - Up * VerticalTraceDepth * 5.0f);
+			LandLocation = GroundHit.bBlockingHit ? GroundHit.ImpactPoint : FVector::ZeroVector;
+			EdgeLocation = Start;
+			break;
+		}
+
+		// The obstacle is longer than a vault, land on top of it.
+		LandLocation = EdgeHit.ImpactPoint;
+	}
+
+	if (LandLocation.IsZero()) return false;
+
+	// Halfway through, the capsule is over the middle of the obstacle and clears its top. A quadratic curve is halfway between
+	// the middle of Start and Target and the control point at that time.
+	const float HalfHeight = GetPawnShape(UpdatedPrimitive, Settings).GetCapsuleHalfHeight();
+	OutTarget = LandLocation + Up * HalfHeight;
+	const FVector Peak = (ObstacleHit.ImpactPoint + EdgeLocation) * 0.5f + Up * (HalfHeight + Settings.TraversalClearance);
+	OutControl = 2.0f * Peak - (Location + OutTarget) * 0.5f;
+	return true;
+}
+
+bool UClimbMoverLibrary::FindClimbableSurface(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings,
+	const FVector& Location, const FQuat& Orientation, FClimbMoverScratch& Scratch, FClimbMoverSurface& OutSurface)
+{
+	// The one unit sweep of UClimbForgeMovementComponent::TraceClimbableSurfaces, timed like it is there.
+	const FVector Forward = Orientation.GetForwardVector();
+	const FVector Start = Location + Forward * 25.0f;
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Settings.ClimbCollisionCapsuleRadius, Settings.ClimbCollisionCapsuleHalfHeight);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ClimbMoverContactsSweep);
+		Scratch.Hits.Reset();
+		UpdatedPrimitive.GetWorld()->SweepMultiByChannel(Scratch.Hits, Start, Start + Forward, FQuat::Identity,
+			Settings.ClimbableSurfaceTraceChannel, CollisionShape, MakeClimbQueryParams(UpdatedPrimitive));
+	}
+	if (Scratch.Hits.IsEmpty()) return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_ClimbMoverContactSummary);
+	Scratch.Contacts.Assign<FHitResult>(Scratch.Hits);
+	const ClimbMath::FClimbContactSummary Summary = ClimbMath::SummarizeContacts(Scratch.Contacts, Forward, ClimbMath::FloorDotProductThreshold,
+		ClimbMath::CeilingDotProductThreshold);
+	if (Summary.BestCandidate == INDEX_NONE) return false;
+
+	OutSurface.Location = Summary.AverageLocation;
+	OutSurface.Normal = Summary.AverageNormal;
+	OutSurface.Component = Scratch.Hits[Summary.BestCandidate].GetComponent();
+	OutSurface.AngleInDegrees = Summary.BestCandidateAngleInDegrees;
+	OutSurface.Steepness = Summary.BestCandidateSteepness;
+	return !ClimbMath::IsFloorOrCeilingNormal(OutSurface.Normal, ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+}
+
+bool UClimbMoverLibrary::IsOnFloor(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+	const FQuat& Orientation, FClimbMoverScratch& Scratch)
+{
+	// The floor sweep of UClimbForgeMovementComponent::HasReachedTheFloor.
+	const FVector Down = -1.0f * Orientation.GetUpVector();
+	const FVector Start = Location + Down * 35.0f;
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Settings.ClimbCollisionCapsuleRadius, Settings.ClimbCollisionCapsuleHalfHeight);
+
+	Scratch.Hits.Reset();
+	UpdatedPrimitive.GetWorld()->SweepMultiByChannel(Scratch.Hits, Start, Start + Down, FQuat::Identity, Settings.ClimbableSurfaceTraceChannel,
+		CollisionShape, MakeClimbQueryParams(UpdatedPrimitive));
+	if (Scratch.Hits.IsEmpty()) return false;
+
+	Scratch.Contacts.Assign<FHitResult>(Scratch.Hits);
+	const ClimbMath::FClimbContactSummary Summary = ClimbMath::SummarizeContacts(Scratch.Contacts, Orientation.GetForwardVector(),
+		ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+	return FMath::Max(Summary.MaxUpDot, -Summary.MinUpDot) >= UE_THRESH_NORMALS_ARE_PARALLEL;
+}
+
+bool UClimbMoverLibrary::FindLedgeTop(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+	const FQuat& Orientation, const float WalkableFloorZ, FVector& OutStandLocation)
+{
+	// The ledge check of UClimbForgeMovementComponent::HasReachedTheLedge: no more wall above the eyes, walkable ground behind it
+	// and room for the capsule there.
+	const FVector Forward = Orientation.GetForwardVector();
+	const FVector Up = Orientation.GetUpVector();
+	const FCollisionShape PawnShape = GetPawnShape(UpdatedPrimitive, Settings);
+	const float TraceDistance = PawnShape.GetCapsuleRadius() * 2.5f;
+
+	const FVector EyeStart = Location + Up * (Settings.ClimbEyeHeight + 20.0f);
+	const FVector EyeEnd = EyeStart + Forward * TraceDistance;
+	if (LineTrace(UpdatedPrimitive, Settings, EyeStart, EyeEnd).bBlockingHit) return false;
+
+	const float HalfHeight = PawnShape.GetCapsuleHalfHeight();
+	const FVector WalkableStart = EyeEnd + Up * HalfHeight;
+	const FHitResult WalkableHit = LineTrace(UpdatedPrimitive, Settings, WalkableStart, WalkableStart - Up * 2.0f * HalfHeight);
+	if (!WalkableHit.bBlockingHit || WalkableHit.ImpactNormal.Z < WalkableFloorZ) return false;
+
+	OutStandLocation = WalkableHit.ImpactPoint + Up * (HalfHeight + 1.0f);
+	return !UpdatedPrimitive.GetWorld()->OverlapBlockingTestByChannel(OutStandLocation, FQuat::Identity, Settings.ClimbableSurfaceTraceChannel,
+		PawnShape, MakeClimbQueryParams(UpdatedPrimitive));
+}
+
+FHitResult UClimbMoverLibrary::LineTrace(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Start,
+	const FVector& End)
+{
+	FHitResult Hit;
+	UpdatedPrimitive.GetWorld()->LineTraceSingleByChannel(Hit, Start, End, Settings.ClimbableSurfaceTraceChannel, MakeClimbQueryParams(UpdatedPrimitive));
+	return Hit;
+}
+
+TSharedPtr<FLayeredMove_ClimbTraversal> UClimbMoverLibrary::MakeTraversal(const FVector& Start, const FVector& Control, const FVector& Target,
+	const float Duration, const FName ModeAfterTraversal)
+{
+	const TSharedPtr<FLayeredMove_ClimbTraversal> Traversal = MakeShared<FLayeredMove_ClimbTraversal>();
+	Traversal->Start = Start;
+	Traversal->Control = Control;
+	Traversal->Target = Target;
+	Traversal->ModeAfterTraversal = ModeAfterTraversal;
+	Traversal->DurationMs = Duration * 1000.0f;
+	return Traversal;
+}
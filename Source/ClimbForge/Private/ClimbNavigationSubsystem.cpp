@@ -0,0 +1,628 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbNavigationSubsystem.h"
+
+#include "ClimbForgeAICharacter.h"
+#include "ClimbForgeStats.h"
+#include "NavArea_Climb.h"
+#include "AIController.h"
+#include "NavLinkCustomComponent.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Algo/Reverse.h"
+#include "Algo/StableSort.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbNavigation, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Climb Nav Build"), STAT_ClimbNavBuild, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climb Nav Find Path"), STAT_ClimbNavFindPath, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Nav Cache Hits"), STAT_ClimbNavCacheHits, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Nav Cache Misses"), STAT_ClimbNavCacheMisses, STATGROUP_ClimbForge);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Climb Nav Nodes"), STAT_ClimbNavNodes, STATGROUP_ClimbForge);
+
+namespace
+{
+	// The horizontal directions the walls are sampled from. The index is part of a wall node's key so that the two faces
+	// of a thin wall stay apart.
+	const FVector SampleDirections[] = { FVector(1.0f, 0.0f, 0.0f), FVector(-1.0f, 0.0f, 0.0f), FVector(0.0f, 1.0f, 0.0f), FVector(0.0f, -1.0f, 0.0f) };
+
+	// How much of a wall normal has to be horizontal, and how much of a ground normal vertical.
+	constexpr float MinWallSteepness = 0.7f;
+	constexpr float MinGroundNormalZ = 0.7f;
+
+	// Wall cells climbed in a straight line before the column walk gives up looking for the ledge.
+	constexpr int32 MaxColumnHeightCells = 256;
+
+	// Steps across the top of a wall looking for the ground behind it.
+	constexpr int32 MaxVaultDepthCells = 4;
+
+	FIntVector GetCell(const FVector& Location, const float CellSize)
+	{
+		return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+	}
+
+	// Ground and ledge top nodes are shared by every face that finds them, wall nodes are per face.
+	FIntVector4 MakeNodeKey(const FIntVector& Cell, const EClimbNavNodeType Type, const int32 Face)
+	{
+		const int32 Kind = Type == EClimbNavNodeType::Wall ? Face : 4 + static_cast<int32>(Type);
+		return FIntVector4(Cell.X, Cell.Y, Cell.Z, Kind);
+	}
+}
+
+void UClimbNavigationSubsystem::BuildClimbGraph(const FBox& Bounds, const FClimbNavBuildSettings& InSettings)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimbNavBuild);
+	ClearClimbGraph();
+	Settings = InSettings;
+
+	UWorld* World = GetWorld();
+	if (World == nullptr || !Bounds.IsValid) return;
+
+	const float CellSize = Settings.CellSize;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbNavBuild), false);
+
+	struct FPendingLink
+	{
+		int32 From;
+		FLink Link;
+	};
+	TArray<FPendingLink> PendingLinks;
+	TMap<FIntVector4, int32> NodeLookup;
+
+	// Per node, only used for wall nodes: cell and face, and the wall node above and the ledge top for the column walk.
+	TArray<FIntVector> WallCells;
+	TArray<int32> WallFaces;
+	TArray<int32> WallAbove;
+	TArray<int32> WallLedge;
+
+	const auto AddNode = [&](const EClimbNavNodeType Type, const FVector& Location, const FVector& Normal, const FIntVector& Cell, const int32 Face)
+	{
+		const FIntVector4 Key = MakeNodeKey(Cell, Type, Face);
+		if (const int32* Existing = NodeLookup.Find(Key)) return *Existing;
+
+		FNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.Location = Location;
+		Node.Normal = Normal;
+		Node.Type = Type;
+
+		const int32 Index = Nodes.Num() - 1;
+		NodeLookup.Add(Key, Index);
+		WallCells.Add(Cell);
+		WallFaces.Add(Face);
+		WallAbove.Add(INDEX_NONE);
+		WallLedge.Add(INDEX_NONE);
+		return Index;
+	};
+
+	const auto AddLink = [&](const int32 From, const int32 To, const EClimbNavLinkType Type, const float ExtraCost, const float CostMultiplier)
+	{
+		FPendingLink& Pending = PendingLinks.AddDefaulted_GetRef();
+		Pending.From = From;
+		Pending.Link.To = To;
+		Pending.Link.Type = Type;
+		Pending.Link.Cost = FVector::Dist(Nodes[From].Location, Nodes[To].Location) * CostMultiplier + ExtraCost;
+	};
+
+	// The same wall cell can land one cell off along the normal when the wall is not perfectly axis aligned.
+	const auto FindWallNode = [&](const FIntVector& Cell, const int32 Face)
+	{
+		const FIntVector NormalAxis = Face < 2 ? FIntVector(1, 0, 0) : FIntVector(0, 1, 0);
+		for (const int32 Offset : { 0, -1, 1 })
+		{
+			if (const int32* Found = NodeLookup.Find(MakeNodeKey(Cell + NormalAxis * Offset, EClimbNavNodeType::Wall, Face))) return *Found;
+		}
+		return static_cast<int32>(INDEX_NONE);
+	};
+
+	const auto TraceGround = [&](const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		return World->LineTraceSingleByChannel(OutHit, Start, End, Settings.TraceChannel, QueryParams) && !OutHit.bStartPenetrating &&
+			OutHit.ImpactNormal.Z >= MinGroundNormalZ;
+	};
+
+	// Wall nodes: march rows of line traces through the bounds from each side. A row only traces once per wall it crosses.
+	const FVector Size = Bounds.GetSize();
+	for (int32 Face = 0; Face < UE_ARRAY_COUNT(SampleDirections); ++Face)
+	{
+		const FVector& Direction = SampleDirections[Face];
+		const bool bAlongX = Face < 2;
+		const FVector Across = bAlongX ? FVector::YAxisVector : FVector::XAxisVector;
+		const float RowLength = bAlongX ? Size.X : Size.Y;
+		const int32 NumAcross = FMath::CeilToInt((bAlongX ? Size.Y : Size.X) / CellSize);
+		const int32 NumUp = FMath::CeilToInt(Size.Z / CellSize);
+
+		for (int32 Up = 0; Up < NumUp; ++Up)
+		{
+			for (int32 Row = 0; Row < NumAcross; ++Row)
+			{
+				FVector RowStart = Bounds.Min + Across * (Row + 0.5f) * CellSize + FVector::UpVector * (Up + 0.5f) * CellSize;
+				if (Direction.X + Direction.Y < 0.0f)
+				{
+					RowStart -= Direction * RowLength;
+				}
+				const FVector RowEnd = RowStart + Direction * RowLength;
+
+				FVector TraceStart = RowStart;
+				while (FVector::DotProduct(RowEnd - TraceStart, Direction) > 0.0f)
+				{
+					FHitResult Hit;
+					if (!World->LineTraceSingleByChannel(Hit, TraceStart, RowEnd, Settings.TraceChannel, QueryParams)) break;
+
+					const FVector Normal = Hit.ImpactNormal;
+					if (!Hit.bStartPenetrating && Normal.Size2D() >= MinWallSteepness && FVector::DotProduct(Normal, Direction) < -0.5f)
+					{
+						AddNode(EClimbNavNodeType::Wall, Hit.ImpactPoint + Normal * Settings.WallOffset, Normal, GetCell(Hit.ImpactPoint, CellSize), Face);
+					}
+
+					// Continue behind the wall. A trace that starts inside the obstacle does not hit it again.
+					TraceStart = Hit.ImpactPoint + Direction * CellSize;
+				}
+			}
+		}
+	}
+
+	const int32 NumWallNodes = Nodes.Num();
+
+	// Links along the walls, and the ground below and the ledge top above the wall ends.
+	TArray<TPair<int32, int32>> MountLinks;
+	for (int32 Wall = 0; Wall < NumWallNodes; ++Wall)
+	{
+		const FIntVector Cell = WallCells[Wall];
+		const int32 Face = WallFaces[Wall];
+		const FIntVector Tangent = Face < 2 ? FIntVector(0, 1, 0) : FIntVector(1, 0, 0);
+
+		for (const FIntVector& Step : { FIntVector(0, 0, 1), FIntVector(0, 0, -1), Tangent, Tangent * -1 })
+		{
+			for (int32 Distance = 1; Distance <= Settings.MaxDashGapCells + 1; ++Distance)
+			{
+				const int32 Neighbor = FindWallNode(Cell + Step * Distance, Face);
+				if (Neighbor == INDEX_NONE) continue;
+
+				if (Distance == 1)
+				{
+					AddLink(Wall, Neighbor, EClimbNavLinkType::Climb, 0.0f, Settings.ClimbCostMultiplier);
+					if (Step.Z > 0)
+					{
+						WallAbove[Wall] = Neighbor;
+					}
+				}
+				else
+				{
+					AddLink(Wall, Neighbor, EClimbNavLinkType::Dash, Settings.ActionCost, Settings.ClimbCostMultiplier);
+				}
+				break;
+			}
+		}
+
+		const FVector WallLocation = Nodes[Wall].Location;
+		const FVector WallNormal = Nodes[Wall].Normal;
+		FHitResult GroundHit;
+
+		if (FindWallNode(Cell - FIntVector(0, 0, 1), Face) == INDEX_NONE &&
+			TraceGround(WallLocation, WallLocation - FVector::UpVector * 2.0f * CellSize, GroundHit))
+		{
+			const int32 Ground = AddNode(EClimbNavNodeType::Ground, GroundHit.ImpactPoint, FVector::UpVector, GetCell(GroundHit.ImpactPoint, CellSize), Face);
+			AddLink(Ground, Wall, EClimbNavLinkType::Mount, 0.0f, Settings.ClimbCostMultiplier);
+			AddLink(Wall, Ground, EClimbNavLinkType::Dismount, 0.0f, 1.0f);
+			MountLinks.Emplace(Ground, Wall);
+		}
+
+		// The top is looked for a little into the wall, between the top of this cell and one cell above it.
+		const FVector WallPoint = WallLocation - WallNormal * (Settings.WallOffset + 0.5f * CellSize);
+		if (WallAbove[Wall] == INDEX_NONE &&
+			TraceGround(WallPoint + FVector::UpVector * 1.5f * CellSize, WallPoint - FVector::UpVector * 0.5f * CellSize, GroundHit))
+		{
+			const int32 Ledge = AddNode(EClimbNavNodeType::LedgeTop, GroundHit.ImpactPoint, FVector::UpVector, GetCell(GroundHit.ImpactPoint, CellSize), Face);
+			AddLink(Wall, Ledge, EClimbNavLinkType::ClimbUp, Settings.ActionCost, Settings.ClimbCostMultiplier);
+			AddLink(Ledge, Wall, EClimbNavLinkType::DropDown, Settings.ActionCost, Settings.ClimbCostMultiplier);
+			WallLedge[Wall] = Ledge;
+		}
+	}
+
+	// Walk each wall straight up from where it is mounted. Reaching a ledge makes a route over the wall for the navmesh, and a
+	// low one is also vaulted if there is ground behind it.
+	TArray<TPair<int32, int32>> NavLinkPairs;
+	for (const TPair<int32, int32>& Mount : MountLinks)
+	{
+		const int32 Ground = Mount.Key;
+		int32 Wall = Mount.Value;
+		for (int32 Height = 0; Height < MaxColumnHeightCells && WallLedge[Wall] == INDEX_NONE && WallAbove[Wall] != INDEX_NONE; ++Height)
+		{
+			Wall = WallAbove[Wall];
+		}
+
+		const int32 Ledge = WallLedge[Wall];
+		if (Ledge == INDEX_NONE) continue;
+
+		NavLinkPairs.Emplace(Ground, Ledge);
+		NavLinkPairs.Emplace(Ledge, Ground);
+
+		const FVector LedgeLocation = Nodes[Ledge].Location;
+		if (LedgeLocation.Z - Nodes[Ground].Location.Z > Settings.MaxVaultHeight) continue;
+
+		const FVector Behind = -Nodes[Wall].Normal.GetSafeNormal2D();
+		for (int32 Depth = 1; Depth <= MaxVaultDepthCells; ++Depth)
+		{
+			const FVector Sample = LedgeLocation + Behind * Depth * CellSize;
+			FHitResult LandingHit;
+			if (!TraceGround(Sample + FVector::UpVector * CellSize, Sample - FVector::UpVector * (Settings.MaxVaultHeight + CellSize), LandingHit)) break;
+
+			// Still on top of the wall.
+			if (LandingHit.ImpactPoint.Z > LedgeLocation.Z - 0.5f * CellSize) continue;
+
+			const int32 Landing = AddNode(EClimbNavNodeType::Ground, LandingHit.ImpactPoint, FVector::UpVector, GetCell(LandingHit.ImpactPoint, CellSize), 0);
+			AddLink(Ground, Landing, EClimbNavLinkType::Vault, Settings.ActionCost, 1.0f);
+			NavLinkPairs.Emplace(Ground, Landing);
+			break;
+		}
+	}
+
+	// Outgoing links of a node are stored next to each other.
+	Algo::StableSortBy(PendingLinks, &FPendingLink::From);
+	Links.Reserve(PendingLinks.Num());
+	for (const FPendingLink& Pending : PendingLinks)
+	{
+		FNode& Node = Nodes[Pending.From];
+		if (Node.NumLinks == 0)
+		{
+			Node.FirstLink = Links.Num();
+		}
+		++Node.NumLinks;
+		Links.Add(Pending.Link);
+	}
+
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const int32 Cluster = GetOrAddCluster(Nodes[Index].Location);
+		Nodes[Index].Cluster = Cluster;
+		Clusters[Cluster].Nodes.Add(Index);
+		Clusters[Cluster].Center += Nodes[Index].Location;
+	}
+
+	for (FCluster& Cluster : Clusters)
+	{
+		Cluster.Center /= Cluster.Nodes.Num();
+	}
+
+	for (const FNode& Node : Nodes)
+	{
+		for (int32 LinkIndex = Node.FirstLink; LinkIndex < Node.FirstLink + Node.NumLinks; ++LinkIndex)
+		{
+			const int32 ToCluster = Nodes[Links[LinkIndex].To].Cluster;
+			if (ToCluster != Node.Cluster)
+			{
+				Clusters[Node.Cluster].Neighbors.AddUnique(ToCluster);
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ClimbNavNodes, Nodes.Num());
+
+	if (Settings.bAddNavLinks)
+	{
+		RegisterNavLinks(NavLinkPairs);
+	}
+}
+
+void UClimbNavigationSubsystem::ClearClimbGraph()
+{
+	UnregisterNavLinks();
+
+	Nodes.Reset();
+	Links.Reset();
+	Clusters.Reset();
+	ClusterLookup.Reset();
+	PathCache.Reset();
+	PathCacheOrder.Reset();
+	NextPathCacheSlot = 0;
+	SearchCost.Reset();
+	SearchParent.Reset();
+	SearchStamp.Reset();
+	SearchGeneration = 0;
+
+	SET_DWORD_STAT(STAT_ClimbNavNodes, 0);
+}
+
+bool UClimbNavigationSubsystem::FindClimbPath(const FVector& Start, const FVector& End, TArray<FClimbNavPathPoint>& OutPath)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimbNavFindPath);
+	OutPath.Reset();
+
+	const int32 StartNode = FindNearestNode(Start);
+	const int32 EndNode = FindNearestNode(End);
+	if (StartNode == INDEX_NONE || EndNode == INDEX_NONE) return false;
+
+	const uint64 Key = static_cast<uint64>(StartNode) << 32 | static_cast<uint32>(EndNode);
+	const TArray<int32>* NodePath = PathCache.Find(Key);
+	TArray<int32> FoundPath;
+
+	if (NodePath != nullptr)
+	{
+		INC_DWORD_STAT(STAT_ClimbNavCacheHits);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ClimbNavCacheMisses);
+
+		// The corridor can be too narrow when the route has to leave it and come back, search the whole graph then.
+		TBitArray<> Corridor;
+		if (FindClusterCorridor(Nodes[StartNode].Cluster, Nodes[EndNode].Cluster, Corridor) &&
+			!FindNodePath(StartNode, EndNode, &Corridor, FoundPath))
+		{
+			FindNodePath(StartNode, EndNode, nullptr, FoundPath);
+		}
+
+		// Failed searches are cached too, so agents do not keep asking for a route that does not exist.
+		AddCachedPath(Key, FoundPath);
+		NodePath = &FoundPath;
+	}
+
+	if (NodePath->IsEmpty()) return false;
+
+	OutPath.Reserve(NodePath->Num());
+	for (int32 Index = 0; Index < NodePath->Num(); ++Index)
+	{
+		const FNode& Node = Nodes[(*NodePath)[Index]];
+		FClimbNavPathPoint& Point = OutPath.AddDefaulted_GetRef();
+		Point.Location = Node.Location;
+		Point.Normal = Node.Normal;
+		Point.NodeType = Node.Type;
+		Point.ArrivedBy = Index > 0 ? GetLinkType((*NodePath)[Index - 1], (*NodePath)[Index]) : EClimbNavLinkType::None;
+	}
+	return true;
+}
+
+void UClimbNavigationSubsystem::Deinitialize()
+{
+	ClearClimbGraph();
+	Super::Deinitialize();
+}
+
+int32 UClimbNavigationSubsystem::FindNearestNode(const FVector& Location) const
+{
+	const FIntVector Center = GetCell(Location, Settings.ClusterSize);
+	int32 Nearest = INDEX_NONE;
+	float NearestDistanceSquared = FMath::Square(Settings.ClusterSize);
+
+	for (int32 X = -1; X <= 1; ++X)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			for (int32 Z = -1; Z <= 1; ++Z)
+			{
+				const int32* Cluster = ClusterLookup.Find(Center + FIntVector(X, Y, Z));
+				if (Cluster == nullptr) continue;
+
+				for (const int32 Node : Clusters[*Cluster].Nodes)
+				{
+					const float DistanceSquared = FVector::DistSquared(Location, Nodes[Node].Location);
+					if (DistanceSquared < NearestDistanceSquared)
+					{
+						NearestDistanceSquared = DistanceSquared;
+						Nearest = Node;
+					}
+				}
+			}
+		}
+	}
+	return Nearest;
+}
+
+bool UClimbNavigationSubsystem::FindClusterCorridor(const int32 StartCluster, const int32 EndCluster, TBitArray<>& OutCorridor) const
+{
+	OutCorridor.Init(false, Clusters.Num());
+
+	// There are few clusters, so the high level search just allocates its own scratch space.
+	TArray<float> Cost;
+	TArray<int32> Parent;
+	Cost.Init(UE_BIG_NUMBER, Clusters.Num());
+	Parent.Init(INDEX_NONE, Clusters.Num());
+
+	const FVector Goal = Clusters[EndCluster].Center;
+	const auto IsCheaper = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; };
+
+	TArray<TPair<float, int32>> Open;
+	Cost[StartCluster] = 0.0f;
+	Open.HeapPush(TPair<float, int32>(FVector::Dist(Clusters[StartCluster].Center, Goal), StartCluster), IsCheaper);
+
+	while (!Open.IsEmpty())
+	{
+		TPair<float, int32> Entry;
+		Open.HeapPop(Entry, IsCheaper, EAllowShrinking::No);
+		const int32 Current = Entry.Value;
+
+		if (Current == EndCluster)
+		{
+			for (int32 Cluster = Current; Cluster != INDEX_NONE; Cluster = Parent[Cluster])
+			{
+				// Neighbors too, so the node search has some room next to the straight corridor.
+				OutCorridor[Cluster] = true;
+				for (const int32 Neighbor : Clusters[Cluster].Neighbors)
+				{
+					OutCorridor[Neighbor] = true;
+				}
+			}
+			return true;
+		}
+
+		for (const int32 Neighbor : Clusters[Current].Neighbors)
+		{
+			const float NewCost = Cost[Current] + FVector::Dist(Clusters[Current].Center, Clusters[Neighbor].Center);
+			if (NewCost >= Cost[Neighbor]) continue;
+
+			Cost[Neighbor] = NewCost;
+			Parent[Neighbor] = Current;
+			Open.HeapPush(TPair<float, int32>(NewCost + FVector::Dist(Clusters[Neighbor].Center, Goal), Neighbor), IsCheaper);
+		}
+	}
+	return false;
+}
+
+bool UClimbNavigationSubsystem::FindNodePath(const int32 StartNode, const int32 EndNode, const TBitArray<>* Corridor, TArray<int32>& OutNodePath)
+{
+	OutNodePath.Reset();
+
+	if (SearchStamp.Num() != Nodes.Num())
+	{
+		SearchCost.SetNumUninitialized(Nodes.Num());
+		SearchParent.SetNumUninitialized(Nodes.Num());
+		SearchStamp.Init(0, Nodes.Num());
+		SearchGeneration = 0;
+	}
+
+	// Stamps instead of clearing the scratch arrays, so a search only touches the nodes it visits.
+	if (++SearchGeneration == 0)
+	{
+		FMemory::Memzero(SearchStamp.GetData(), SearchStamp.Num() * sizeof(uint32));
+		SearchGeneration = 1;
+	}
+
+	const FVector Goal = Nodes[EndNode].Location;
+	const auto IsCheaper = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; };
+
+	TArray<TPair<float, int32>> Open;
+	SearchCost[StartNode] = 0.0f;
+	SearchParent[StartNode] = INDEX_NONE;
+	SearchStamp[StartNode] = SearchGeneration;
+	Open.HeapPush(TPair<float, int32>(FVector::Dist(Nodes[StartNode].Location, Goal), StartNode), IsCheaper);
+
+	while (!Open.IsEmpty())
+	{
+		TPair<float, int32> Entry;
+		Open.HeapPop(Entry, IsCheaper, EAllowShrinking::No);
+		const int32 Current = Entry.Value;
+
+		if (Current == EndNode)
+		{
+			for (int32 Node = Current; Node != INDEX_NONE; Node = SearchParent[Node])
+			{
+				OutNodePath.Add(Node);
+			}
+			Algo::Reverse(OutNodePath);
+			return true;
+		}
+
+		// The node was queued again with a lower cost after this entry, it has been expanded already.
+		const float CurrentCost = SearchCost[Current];
+		if (Entry.Key > CurrentCost + FVector::Dist(Nodes[Current].Location, Goal) + UE_KINDA_SMALL_NUMBER) continue;
+
+		const FNode& Node = Nodes[Current];
+		for (int32 LinkIndex = Node.FirstLink; LinkIndex < Node.FirstLink + Node.NumLinks; ++LinkIndex)
+		{
+			const FLink& Link = Links[LinkIndex];
+			if (Corridor != nullptr && !(*Corridor)[Nodes[Link.To].Cluster]) continue;
+
+			const float NewCost = CurrentCost + Link.Cost;
+			if (SearchStamp[Link.To] == SearchGeneration && NewCost >= SearchCost[Link.To]) continue;
+
+			SearchCost[Link.To] = NewCost;
+			SearchParent[Link.To] = Current;
+			SearchStamp[Link.To] = SearchGeneration;
+			Open.HeapPush(TPair<float, int32>(NewCost + FVector::Dist(Nodes[Link.To].Location, Goal), Link.To), IsCheaper);
+		}
+	}
+	return false;
+}
+
+void UClimbNavigationSubsystem::AddCachedPath(const uint64 Key, const TArray<int32>& NodePath)
+{
+	if (PathCacheOrder.Num() < Settings.MaxCachedPaths)
+	{
+		PathCacheOrder.Add(Key);
+	}
+	else
+	{
+		// Full, replace the oldest entry.
+		PathCache.Remove(PathCacheOrder[NextPathCacheSlot]);
+		PathCacheOrder[NextPathCacheSlot] = Key;
+		NextPathCacheSlot = (NextPathCacheSlot + 1) % PathCacheOrder.Num();
+	}
+	PathCache.Add(Key, NodePath);
+}
+
+EClimbNavLinkType UClimbNavigationSubsystem::GetLinkType(const int32 From, const int32 To) const
+{
+	const FNode& Node = Nodes[From];
+	for (int32 LinkIndex = Node.FirstLink; LinkIndex < Node.FirstLink + Node.NumLinks; ++LinkIndex)
+	{
+		if (Links[LinkIndex].To == To) return Links[LinkIndex].Type;
+	}
+	return EClimbNavLinkType::None;
+}
+
+int32 UClimbNavigationSubsystem::GetOrAddCluster(const FVector& Location)
+{
+	const FIntVector Cell = GetCell(Location, Settings.ClusterSize);
+	if (const int32* Existing = ClusterLookup.Find(Cell)) return *Existing;
+
+	const int32 Index = Clusters.AddDefaulted();
+	ClusterLookup.Add(Cell, Index);
+	return Index;
+}
+
+void UClimbNavigationSubsystem::RegisterNavLinks(const TArray<TPair<int32, int32>>& NavLinkPairs)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || NavLinkPairs.IsEmpty()) return;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	NavLinkHost = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	if (NavLinkHost == nullptr) return;
+
+	// A smart link per route, so the path following stops at its start and lets the climber cross it. The host sits at the origin,
+	// so the link ends are in world space.
+	NavLinkComponents.Reset(NavLinkPairs.Num());
+	for (const TPair<int32, int32>& Pair : NavLinkPairs)
+	{
+		UNavLinkCustomComponent* Link = NewObject<UNavLinkCustomComponent>(NavLinkHost);
+		Link->SetLinkData(Nodes[Pair.Key].Location, Nodes[Pair.Value].Location, ENavLinkDirection::LeftToRight);
+		Link->SetEnabledArea(UNavArea_Climb::StaticClass());
+		Link->SetMoveReachedLink(UNavLinkCustomComponent::FOnMoveReachedLink::CreateUObject(this, &UClimbNavigationSubsystem::OnClimbNavLinkReached));
+		Link->RegisterComponent();
+		NavLinkComponents.Add(Link);
+	}
+
+	// Links registered at runtime only reach a navmesh that rebuilds its tiles at runtime.
+	if (const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		for (const ANavigationData* NavData : NavigationSystem->NavDataSet)
+		{
+			if (NavData != nullptr && NavData->GetRuntimeGenerationMode() == ERuntimeGenerationType::Static)
+			{
+				UE_LOG(LogClimbNavigation, Warning, TEXT("%s is static, the %d climb nav links are not part of it. Set its RuntimeGeneration to DynamicModifiersOnly or Dynamic in the level."),
+					*NavData->GetName(), NavLinkPairs.Num());
+			}
+		}
+	}
+}
+
+void UClimbNavigationSubsystem::UnregisterNavLinks()
+{
+	if (NavLinkHost != nullptr)
+	{
+		NavLinkHost->Destroy();
+	}
+	NavLinkHost = nullptr;
+	NavLinkComponents.Reset();
+}
+
+void UClimbNavigationSubsystem::OnClimbNavLinkReached(UNavLinkCustomComponent* Link, UObject* PathComp, const FVector& DestPoint)
+{
+	UPathFollowingComponent* PathFollowing = Cast<UPathFollowingComponent>(PathComp);
+	if (PathFollowing == nullptr || Link == nullptr) return;
+
+	const AAIController* Controller = Cast<AAIController>(PathFollowing->GetOwner());
+	AClimbForgeAICharacter* Climber = Controller != nullptr ? Cast<AClimbForgeAICharacter>(Controller->GetPawn()) : nullptr;
+	if (Climber != nullptr && Climber->StartClimbNavLink(*Link, *PathFollowing, DestPoint)) return;
+
+	// Walking the link would run into the wall.
+	UE_LOG(LogClimbNavigation, Verbose, TEXT("%s can't cross the climb nav link to %s, aborting its move."), *GetNameSafe(PathFollowing->GetOwner()),
+		*DestPoint.ToString());
+	PathFollowing->AbortMove(*this, FPathFollowingResultFlags::InvalidPath);
+}
@@ -0,0 +1,164 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbQueryBudgetSubsystem.h"
+
+#include "ClimbForgeMovementComponent.h"
+#include "ClimbForgeStats.h"
+#include "Algo/Sort.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Queries Admitted"), STAT_ClimbQueriesAdmitted, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Queries Deferred"), STAT_ClimbQueriesDeferred, STATGROUP_ClimbForge);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Climb Query Average Wait (ms)"), STAT_ClimbQueryAverageWait, STATGROUP_ClimbForge);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Climb Query Max Wait (ms)"), STAT_ClimbQueryMaxWait, STATGROUP_ClimbForge);
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarClimbQueryBudget(
+		TEXT("ClimbForge.QueryBudget"),
+		24,
+		TEXT("How many climbers may run their climb queries per frame, players not included. 0 disables the budget."));
+
+	TAutoConsoleVariable<int32> CVarClimbQueryAgingFrames(
+		TEXT("ClimbForge.QueryBudget.AgingFrames"),
+		4,
+		TEXT("Frames a deferred climb query waits before it is served like one of the next higher priority."));
+
+	TAutoConsoleVariable<float> CVarClimbQueryFarDistance(
+		TEXT("ClimbForge.QueryBudget.FarDistance"),
+		4000.0f,
+		TEXT("AI climbers further than this from every local player's view are served like off-screen ones."));
+}
+
+bool UClimbQueryBudgetSubsystem::TryAdmit(const UClimbForgeMovementComponent& Climber)
+{
+	const int32 Budget = CVarClimbQueryBudget.GetValueOnGameThread();
+	if (Budget <= 0) return true;
+
+	FRequest& Request = Requests.FindOrAdd(&Climber);
+	if (Request.AdmittedFrame == GFrameCounter) return true;
+
+	const bool bIsFirstRequestThisFrame = Request.LastRequestFrame != GFrameCounter;
+	Request.LastRequestFrame = GFrameCounter;
+	Request.Priority = GetPriority(Climber);
+
+	const bool bHasFreeSlot = NumAdmitted + NumReserved < Budget;
+	if (!Request.bHasReservedSlot && !bHasFreeSlot && Request.Priority != EClimbQueryPriority::Player)
+	{
+		if (Request.DeferredFrame == 0)
+		{
+			Request.DeferredFrame = GFrameCounter;
+			Request.DeferredTime = FPlatformTime::Seconds();
+		}
+		if (bIsFirstRequestThisFrame)
+		{
+			INC_DWORD_STAT(STAT_ClimbQueriesDeferred);
+		}
+		return false;
+	}
+
+	if (Request.bHasReservedSlot)
+	{
+		Request.bHasReservedSlot = false;
+		--NumReserved;
+	}
+
+	if (Request.DeferredFrame != 0)
+	{
+		const double WaitSeconds = FPlatformTime::Seconds() - Request.DeferredTime;
+		++NumWaitsFinished;
+		TotalWaitSeconds += WaitSeconds;
+		MaxWaitSeconds = FMath::Max(MaxWaitSeconds, WaitSeconds);
+		Request.DeferredFrame = 0;
+	}
+
+	Request.AdmittedFrame = GFrameCounter;
+	// Players are admitted on top of the budget and do not use up the slots of the other climbers.
+	if (Request.Priority != EClimbQueryPriority::Player)
+	{
+		++NumAdmitted;
+	}
+	INC_DWORD_STAT(STAT_ClimbQueriesAdmitted);
+	return true;
+}
+
+void UClimbQueryBudgetSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SET_FLOAT_STAT(STAT_ClimbQueryAverageWait, NumWaitsFinished > 0 ? TotalWaitSeconds / NumWaitsFinished * 1000.0 : 0.0);
+	SET_FLOAT_STAT(STAT_ClimbQueryMaxWait, MaxWaitSeconds * 1000.0);
+	NumAdmitted = 0;
+	NumReserved = 0;
+	NumWaitsFinished = 0;
+	TotalWaitSeconds = 0.0;
+	MaxWaitSeconds = 0.0;
+
+	// Climbers that did not ask this frame no longer need a slot, including any that was reserved for them.
+	TArray<TPair<int64, TObjectKey<UClimbForgeMovementComponent>>, TInlineAllocator<64>> Waiting;
+	const int64 AgingFrames = FMath::Max(1, CVarClimbQueryAgingFrames.GetValueOnGameThread());
+	for (auto It = Requests.CreateIterator(); It; ++It)
+	{
+		FRequest& Request = It.Value();
+		Request.bHasReservedSlot = false;
+
+		if (Request.LastRequestFrame != GFrameCounter)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Request.DeferredFrame != 0)
+		{
+			// Every AgingFrames waited count as one priority level, so far away climbers are served eventually too.
+			const int64 FramesWaited = static_cast<int64>(GFrameCounter - Request.DeferredFrame);
+			Waiting.Emplace(static_cast<int64>(Request.Priority) * AgingFrames - FramesWaited, It.Key());
+		}
+	}
+
+	// Reserve next frame's slots for the most urgent waiting climbers, before anyone else can take them.
+	const int32 Budget = CVarClimbQueryBudget.GetValueOnGameThread();
+	const int32 NumToReserve = FMath::Min(Budget, Waiting.Num());
+	if (NumToReserve < Waiting.Num())
+	{
+		Algo::SortBy(Waiting, &TPair<int64, TObjectKey<UClimbForgeMovementComponent>>::Key);
+	}
+
+	for (int32 Index = 0; Index < NumToReserve; ++Index)
+	{
+		Requests[Waiting[Index].Value].bHasReservedSlot = true;
+	}
+	NumReserved = NumToReserve;
+}
+
+TStatId UClimbQueryBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbQueryBudgetSubsystem, STATGROUP_Tickables);
+}
+
+EClimbQueryPriority UClimbQueryBudgetSubsystem::GetPriority(const UClimbForgeMovementComponent& Climber) const
+{
+	const APawn* Pawn = Climber.GetPawnOwner();
+	if (Pawn == nullptr) return EClimbQueryPriority::Hidden;
+	if (Pawn->IsPlayerControlled()) return EClimbQueryPriority::Player;
+	if (!Pawn->WasRecentlyRendered()) return EClimbQueryPriority::Hidden;
+
+	// Rendered for some local player, but it may only be a speck in the distance.
+	const float FarDistanceSquared = FMath::Square(CVarClimbQueryFarDistance.GetValueOnGameThread());
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr || !PlayerController->IsLocalController()) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		if (FVector::DistSquared(ViewLocation, Pawn->GetActorLocation()) < FarDistanceSquared) return EClimbQueryPriority::Visible;
+	}
+	return EClimbQueryPriority::Hidden;
+}
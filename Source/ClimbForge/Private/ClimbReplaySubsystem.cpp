@@ -0,0 +1,556 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbReplaySubsystem.h"
+
+#include "ClimbForgeCharacter.h"
+#include "ClimbForgeMovementComponent.h"
+#include "ClimbForgeStats.h"
+#include "CustomMovementMode.h"
+#include "JsonObjectConverter.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbReplay, Log, All);
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Climb Replay Frame (ms)"), STAT_ClimbReplayFrame, STATGROUP_ClimbForge);
+
+namespace
+{
+	// Frames replayed after the last input, so whatever it started can finish.
+	constexpr float ClimbReplaySettleTime = 1.0f;
+
+	// Seconds a command line replay waits for the player character before it gives up, e.g. on a map without a player start.
+	constexpr double ClimbReplayPendingTimeout = 30.0;
+
+	TAutoConsoleVariable<float> CVarClimbReplayLocationTolerance(
+		TEXT("ClimbForge.Replay.LocationTolerance"),
+		1.0f,
+		TEXT("How far a replayed location may be from the golden one."));
+
+	TAutoConsoleVariable<float> CVarClimbReplayRotationTolerance(
+		TEXT("ClimbForge.Replay.RotationTolerance"),
+		1.0f,
+		TEXT("How many degrees a replayed rotation may be off from the golden one."));
+
+	TAutoConsoleVariable<int32> CVarClimbReplayFrameTolerance(
+		TEXT("ClimbForge.Replay.FrameTolerance"),
+		2,
+		TEXT("How many frames a movement mode or montage change may be early or late compared to the golden timeline."));
+
+	TAutoConsoleVariable<float> CVarClimbReplayMaxSlowdown(
+		TEXT("ClimbForge.Replay.MaxSlowdownPercent"),
+		0.0f,
+		TEXT("Fail the replay if its average frame time is this many percent above the golden one. 0 only reports the difference."));
+
+	FString GetDefaultRecordingPath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ClimbReplays") / FString::Printf(TEXT("ClimbInput-%s.json"), *FDateTime::Now().ToString());
+	}
+
+	FString GetSiblingPath(const FString& RecordingPath, const TCHAR* Suffix)
+	{
+		return FPaths::GetBaseFilename(RecordingPath, false) + Suffix;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CVarClimbRecordInput(
+		TEXT("ClimbForge.RecordInput"),
+		TEXT("Starts recording the player's climb input, or stops and saves it if a recording is running. Usage: ClimbForge.RecordInput [FilePath]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UClimbReplaySubsystem* Replay = World != nullptr ? World->GetSubsystem<UClimbReplaySubsystem>() : nullptr;
+			if (Replay == nullptr) return;
+
+			if (Replay->IsRecording())
+			{
+				Replay->StopRecording(Args.Num() > 0 ? Args[0] : GetDefaultRecordingPath());
+			}
+			else
+			if (AClimbForgeCharacter* Character = Cast<AClimbForgeCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+			{
+				Replay->StartRecording(*Character);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs CVarClimbReplayInput(
+		TEXT("ClimbForge.ReplayInput"),
+		TEXT("Replays a climb input recording on the player. Usage: ClimbForge.ReplayInput RecordingPath [GoldenPath] [UpdateGolden]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UClimbReplaySubsystem* Replay = World != nullptr ? World->GetSubsystem<UClimbReplaySubsystem>() : nullptr;
+			if (Replay == nullptr || Args.Num() == 0) return;
+
+			Replay->StartReplay(Args[0], Args.Num() > 1 ? Args[1] : FString(), Args.Num() > 2 && Args[2].ToBool());
+		}));
+}
+
+bool UClimbReplaySubsystem::StartRecording(AClimbForgeCharacter& InCharacter)
+{
+	if (State != EState::Idle) return false;
+
+	const UClimbForgeMovementComponent* MovementComponent = InCharacter.GetClimbForgeMovementComponent();
+	if (MovementComponent == nullptr || MovementComponent->IsClimbing() || MovementComponent->IsHanging() || MovementComponent->IsFalling())
+	{
+		UE_LOG(LogClimbReplay, Warning, TEXT("Climb input recording has to start on the ground, a replay always starts there"));
+		return false;
+	}
+
+	Character = &InCharacter;
+	Recording = FClimbInputRecording();
+	Recording.MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	Recording.StartTransform = InCharacter.GetActorTransform();
+	Recording.StartControlRotation = InCharacter.GetControlRotation();
+	RecordingStartTime = GetWorld()->GetTimeSeconds();
+
+	LastMoveValue = FVector::ZeroVector;
+	LastClimbMoveValue = FVector::ZeroVector;
+	LastControlRotation = Recording.StartControlRotation;
+
+	InCharacter.SetRecordingInput(true);
+	State = EState::Recording;
+	UE_LOG(LogClimbReplay, Display, TEXT("Recording climb input of %s"), *InCharacter.GetName());
+	return true;
+}
+
+bool UClimbReplaySubsystem::StopRecording(const FString& FilePath)
+{
+	if (State != EState::Recording) return false;
+
+	State = EState::Idle;
+	Recording.Duration = GetWorld()->GetTimeSeconds() - RecordingStartTime;
+	if (Character.IsValid())
+	{
+		Character->SetRecordingInput(false);
+	}
+	Character.Reset();
+
+	FString Json;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Recording, Json) || !FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		UE_LOG(LogClimbReplay, Warning, TEXT("Failed to write the climb input recording to %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogClimbReplay, Display, TEXT("Wrote %d climb inputs over %.1fs to %s"), Recording.Inputs.Num(), Recording.Duration, *FilePath);
+	return true;
+}
+
+void UClimbReplaySubsystem::RecordInput(const EClimbRecordedAction Action, const FInputActionValue& Value)
+{
+	if (State != EState::Recording) return;
+
+	// Held actions trigger every frame, at whatever frame rate the recording ran at. Only their changes are kept.
+	const FVector ActionValue = Value.Get<FVector>();
+	FVector* LastValue = Action == EClimbRecordedAction::Move ? &LastMoveValue : Action == EClimbRecordedAction::ClimbMove ? &LastClimbMoveValue : nullptr;
+	if (LastValue != nullptr)
+	{
+		if (*LastValue == ActionValue) return;
+		*LastValue = ActionValue;
+	}
+
+	FClimbRecordedInput& Input = Recording.Inputs.AddDefaulted_GetRef();
+	Input.Time = GetWorld()->GetTimeSeconds() - RecordingStartTime;
+	Input.Action = Action;
+	Input.ValueType = Value.GetValueType();
+	Input.Value = ActionValue;
+}
+
+void UClimbReplaySubsystem::SampleControlRotation()
+{
+	if (!Character.IsValid())
+	{
+		UE_LOG(LogClimbReplay, Warning, TEXT("The recorded character is gone, climb input recording stopped without saving"));
+		State = EState::Idle;
+		return;
+	}
+
+	const FRotator ControlRotation = Character->GetControlRotation();
+	if (ControlRotation == LastControlRotation) return;
+	LastControlRotation = ControlRotation;
+
+	FClimbRecordedInput& Input = Recording.Inputs.AddDefaulted_GetRef();
+	Input.Time = GetWorld()->GetTimeSeconds() - RecordingStartTime;
+	Input.Action = EClimbRecordedAction::ControlRotation;
+	Input.ValueType = EInputActionValueType::Axis3D;
+	Input.Value = FVector(ControlRotation.Pitch, ControlRotation.Yaw, ControlRotation.Roll);
+}
+
+bool UClimbReplaySubsystem::StartReplay(const FString& InRecordingPath, const FString& InGoldenPath, const bool bInUpdateGolden)
+{
+	if (State != EState::Idle && State != EState::ReplayPending) return false;
+
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *InRecordingPath) || !FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Recording))
+	{
+		UE_LOG(LogClimbReplay, Error, TEXT("Failed to read the climb input recording %s"), *InRecordingPath);
+		return false;
+	}
+
+	AClimbForgeCharacter* PlayerCharacter = Cast<AClimbForgeCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	APlayerController* PlayerController = PlayerCharacter != nullptr ? Cast<APlayerController>(PlayerCharacter->GetController()) : nullptr;
+	if (PlayerController == nullptr || PlayerCharacter->GetClimbForgeMovementComponent() == nullptr)
+	{
+		UE_LOG(LogClimbReplay, Error, TEXT("Climb replay needs a player controlled AClimbForgeCharacter"));
+		return false;
+	}
+
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	if (MapName != Recording.MapName)
+	{
+		UE_LOG(LogClimbReplay, Warning, TEXT("Climb input was recorded on %s but is replayed on %s"), *Recording.MapName, *MapName);
+	}
+
+	Character = PlayerCharacter;
+	RecordingPath = InRecordingPath;
+	GoldenPath = InGoldenPath.IsEmpty() ? GetSiblingPath(InRecordingPath, TEXT(".golden.json")) : InGoldenPath;
+	bUpdateGolden = bInUpdateGolden;
+
+	// Same step every frame, and nothing waits between frames, so the run is both repeatable and a timing measurement.
+	bHadFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(ReplayDeltaTime);
+
+	// Live input must not mix in, the replay drives the handlers directly.
+	PlayerCharacter->DisableInput(PlayerController);
+	PlayerCharacter->SetActorTransform(Recording.StartTransform, false, nullptr, ETeleportType::ResetPhysics);
+	PlayerController->SetControlRotation(Recording.StartControlRotation);
+
+	UClimbForgeMovementComponent* MovementComponent = PlayerCharacter->GetClimbForgeMovementComponent();
+	MovementComponent->ResetClimbState();
+	MovementComponent->StopMovementImmediately();
+	MovementComponent->SetDefaultMovementMode();
+
+	// Nothing is rendered with -nullrhi, montages and their root motion still have to play.
+	PreviousAnimTickOption = PlayerCharacter->GetMesh()->VisibilityBasedAnimTickOption;
+	PlayerCharacter->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	Result = FClimbReplayResult();
+	Result.FixedDeltaTime = ReplayDeltaTime;
+	ReplayFrame = 0;
+	NextInput = 0;
+	HeldMove = FInputActionValue(EInputActionValueType::Axis2D, FVector::ZeroVector);
+	HeldClimbMove = FInputActionValue(EInputActionValueType::Axis2D, FVector::ZeroVector);
+	FrameMs.Reset();
+	LastFrameTime = 0.0;
+
+	State = EState::Replaying;
+	UE_LOG(LogClimbReplay, Display, TEXT("Replaying %d climb inputs from %s at %.1f fps"), Recording.Inputs.Num(), *InRecordingPath, 1.0f / ReplayDeltaTime);
+	return true;
+}
+
+void UClimbReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	if (!InWorld.IsGameWorld()) return;
+
+	FString CommandLineRecordingPath;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("ClimbReplay="), CommandLineRecordingPath)) return;
+
+	RecordingPath = CommandLineRecordingPath;
+	GoldenPath.Reset();
+	FParse::Value(FCommandLine::Get(), TEXT("ClimbReplayGolden="), GoldenPath);
+	bUpdateGolden = FParse::Param(FCommandLine::Get(), TEXT("ClimbReplayUpdateGolden"));
+
+	float FramesPerSecond = 60.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("ClimbReplayFPS="), FramesPerSecond);
+	ReplayDeltaTime = 1.0f / FMath::Max(FramesPerSecond, 1.0f);
+
+	bExitWhenDone = true;
+	ReplayPendingStartTime = FPlatformTime::Seconds();
+	State = EState::ReplayPending;
+}
+
+void UClimbReplaySubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	switch (State)
+	{
+		case EState::Recording:
+			SampleControlRotation();
+			break;
+
+		case EState::ReplayPending:
+			// The player may not be possessed on the first frames.
+			if (UGameplayStatics::GetPlayerCharacter(GetWorld(), 0) != nullptr)
+			{
+				if (!StartReplay(RecordingPath, GoldenPath, bUpdateGolden))
+				{
+					State = EState::Idle;
+					FPlatformMisc::RequestExitWithStatus(false, 1);
+				}
+			}
+			else
+			if (FPlatformTime::Seconds() - ReplayPendingStartTime > ClimbReplayPendingTimeout)
+			{
+				UE_LOG(LogClimbReplay, Error, TEXT("No player character after %.0fs, the climb replay of %s did not run"), ClimbReplayPendingTimeout,
+					*RecordingPath);
+				State = EState::Idle;
+				FPlatformMisc::RequestExitWithStatus(false, 1);
+			}
+			break;
+
+		case EState::Replaying:
+			TickReplay();
+			break;
+
+		default:
+			break;
+	}
+}
+
+TStatId UClimbReplaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbReplaySubsystem, STATGROUP_Tickables);
+}
+
+void UClimbReplaySubsystem::TickReplay()
+{
+	if (!Character.IsValid())
+	{
+		UE_LOG(LogClimbReplay, Error, TEXT("The replayed character is gone"));
+		FinishReplay();
+		return;
+	}
+
+	// The first tick only marks the start, replay started in the middle of a frame.
+	const double Now = FPlatformTime::Seconds();
+	if (LastFrameTime > 0.0)
+	{
+		const double Ms = (Now - LastFrameTime) * 1000.0;
+		FrameMs.Add(Ms);
+		SET_FLOAT_STAT(STAT_ClimbReplayFrame, Ms);
+
+		CaptureFrame();
+		++ReplayFrame;
+	}
+	LastFrameTime = Now;
+
+	if (ReplayFrame * ReplayDeltaTime >= Recording.Duration + ClimbReplaySettleTime)
+	{
+		FinishReplay();
+		return;
+	}
+
+	// Feed everything that was recorded up to the end of the next frame, the character consumes it when it ticks.
+	const float NextFrameTime = (ReplayFrame + 1) * ReplayDeltaTime;
+	for (; NextInput < Recording.Inputs.Num() && Recording.Inputs[NextInput].Time < NextFrameTime; ++NextInput)
+	{
+		const FClimbRecordedInput& Input = Recording.Inputs[NextInput];
+		const FInputActionValue Value(Input.ValueType, Input.Value);
+		switch (Input.Action)
+		{
+			case EClimbRecordedAction::Move:
+				HeldMove = Value;
+				break;
+
+			case EClimbRecordedAction::ClimbMove:
+				HeldClimbMove = Value;
+				break;
+
+			case EClimbRecordedAction::ControlRotation:
+				if (AController* Controller = Character->GetController())
+				{
+					Controller->SetControlRotation(FRotator(Input.Value.X, Input.Value.Y, Input.Value.Z));
+				}
+				break;
+
+			default:
+				Character->ReplayInput(Input.Action, Value);
+				break;
+		}
+	}
+
+	// Held actions trigger every frame they are held, like they did live.
+	if (HeldMove.IsNonZero())
+	{
+		Character->ReplayInput(EClimbRecordedAction::Move, HeldMove);
+	}
+	if (HeldClimbMove.IsNonZero())
+	{
+		Character->ReplayInput(EClimbRecordedAction::ClimbMove, HeldClimbMove);
+	}
+}
+
+void UClimbReplaySubsystem::CaptureFrame()
+{
+	FClimbReplaySample& Sample = Result.Trajectory.AddDefaulted_GetRef();
+	Sample.Location = Character->GetActorLocation();
+	Sample.Rotation = Character->GetActorRotation();
+
+	const FString ModeName = GetMovementModeName();
+	if (Result.MovementModes.IsEmpty() || Result.MovementModes.Last().Name != ModeName)
+	{
+		FClimbReplayTimelineEntry& Entry = Result.MovementModes.AddDefaulted_GetRef();
+		Entry.Frame = ReplayFrame;
+		Entry.Name = ModeName;
+	}
+
+	const UAnimInstance* AnimInstance = Character->GetMesh()->GetAnimInstance();
+	const UAnimMontage* Montage = AnimInstance != nullptr ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+	const FString MontageName = Montage != nullptr ? Montage->GetName() : TEXT("None");
+	if (Result.Montages.IsEmpty() || Result.Montages.Last().Name != MontageName)
+	{
+		FClimbReplayTimelineEntry& Entry = Result.Montages.AddDefaulted_GetRef();
+		Entry.Frame = ReplayFrame;
+		Entry.Name = MontageName;
+	}
+}
+
+void UClimbReplaySubsystem::FinishReplay()
+{
+	State = EState::Idle;
+	FApp::SetUseFixedTimeStep(bHadFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+	if (Character.IsValid())
+	{
+		Character->EnableInput(Cast<APlayerController>(Character->GetController()));
+		Character->GetMesh()->VisibilityBasedAnimTickOption = PreviousAnimTickOption;
+	}
+	Character.Reset();
+
+	if (!FrameMs.IsEmpty())
+	{
+		TArray<double> SortedFrameMs = FrameMs;
+		SortedFrameMs.Sort();
+		for (const double Ms : SortedFrameMs)
+		{
+			Result.TotalMs += Ms;
+		}
+		Result.AverageFrameMs = Result.TotalMs / SortedFrameMs.Num();
+		Result.P95FrameMs = SortedFrameMs[FMath::Min(FMath::FloorToInt(SortedFrameMs.Num() * 0.95f), SortedFrameMs.Num() - 1)];
+		Result.MaxFrameMs = SortedFrameMs.Last();
+	}
+
+	UE_LOG(LogClimbReplay, Display, TEXT("Climb replay of %s: %d frames in %.1f ms, average %.3f ms, p95 %.3f ms, max %.3f ms"), *RecordingPath,
+		Result.Trajectory.Num(), Result.TotalMs, Result.AverageFrameMs, Result.P95FrameMs, Result.MaxFrameMs);
+
+	// The latest result is always kept next to the recording, for diffing against the golden file by hand.
+	FString Json;
+	FJsonObjectConverter::UStructToJsonObjectString(Result, Json);
+	FFileHelper::SaveStringToFile(Json, *GetSiblingPath(RecordingPath, TEXT(".replay.json")));
+
+	bool bPassed = false;
+	if (bUpdateGolden)
+	{
+		bPassed = FFileHelper::SaveStringToFile(Json, *GoldenPath);
+		UE_LOG(LogClimbReplay, Display, TEXT("%s the climb replay golden file %s"), bPassed ? TEXT("Updated") : TEXT("Failed to write"), *GoldenPath);
+	}
+	else
+	{
+		FClimbReplayResult Golden;
+		FString GoldenJson;
+		if (!FFileHelper::LoadFileToString(GoldenJson, *GoldenPath) || !FJsonObjectConverter::JsonObjectStringToUStruct(GoldenJson, &Golden))
+		{
+			UE_LOG(LogClimbReplay, Error, TEXT("Failed to read the climb replay golden file %s"), *GoldenPath);
+		}
+		else
+		{
+			bPassed = CompareWithGolden(Golden);
+
+			const double Slowdown = Golden.AverageFrameMs > 0.0 ? (Result.AverageFrameMs / Golden.AverageFrameMs - 1.0) * 100.0 : 0.0;
+			const float MaxSlowdown = CVarClimbReplayMaxSlowdown.GetValueOnGameThread();
+			UE_LOG(LogClimbReplay, Display, TEXT("Climb replay average frame time %+.1f%% against the golden run (%.3f ms)"), Slowdown, Golden.AverageFrameMs);
+			if (MaxSlowdown > 0.0f && Slowdown > MaxSlowdown)
+			{
+				UE_LOG(LogClimbReplay, Error, TEXT("Climb replay is more than %.1f%% slower than the golden run"), MaxSlowdown);
+				bPassed = false;
+			}
+		}
+
+		UE_LOG(LogClimbReplay, Display, TEXT("Climb replay %s"), bPassed ? TEXT("matched the golden file") : TEXT("FAILED"));
+	}
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+bool UClimbReplaySubsystem::CompareWithGolden(const FClimbReplayResult& Golden) const
+{
+	if (!FMath::IsNearlyEqual(Golden.FixedDeltaTime, Result.FixedDeltaTime))
+	{
+		UE_LOG(LogClimbReplay, Error, TEXT("Golden file was made at a time step of %.4fs, the replay ran at %.4fs"), Golden.FixedDeltaTime, Result.FixedDeltaTime);
+		return false;
+	}
+
+	bool bMatches = true;
+	if (Golden.Trajectory.Num() != Result.Trajectory.Num())
+	{
+		UE_LOG(LogClimbReplay, Error, TEXT("Replay ran %d frames, the golden run %d"), Result.Trajectory.Num(), Golden.Trajectory.Num());
+		bMatches = false;
+	}
+
+	// Report where the motion first drifts off, everything after it is usually off as a consequence.
+	const float LocationTolerance = CVarClimbReplayLocationTolerance.GetValueOnGameThread();
+	const float RotationTolerance = CVarClimbReplayRotationTolerance.GetValueOnGameThread();
+	double MaxLocationError = 0.0;
+	double MaxRotationError = 0.0;
+	int32 FirstDivergentFrame = INDEX_NONE;
+	for (int32 Frame = 0; Frame < FMath::Min(Golden.Trajectory.Num(), Result.Trajectory.Num()); ++Frame)
+	{
+		const FClimbReplaySample& Expected = Golden.Trajectory[Frame];
+		const FClimbReplaySample& Actual = Result.Trajectory[Frame];
+		const double LocationError = FVector::Dist(Expected.Location, Actual.Location);
+		const double RotationError = FMath::RadiansToDegrees(Expected.Rotation.Quaternion().AngularDistance(Actual.Rotation.Quaternion()));
+		MaxLocationError = FMath::Max(MaxLocationError, LocationError);
+		MaxRotationError = FMath::Max(MaxRotationError, RotationError);
+
+		if (FirstDivergentFrame == INDEX_NONE && (LocationError > LocationTolerance || RotationError > RotationTolerance))
+		{
+			FirstDivergentFrame = Frame;
+			UE_LOG(LogClimbReplay, Error, TEXT("Trajectory diverges at frame %d: %s instead of %s"), Frame, *Actual.Location.ToCompactString(),
+				*Expected.Location.ToCompactString());
+		}
+	}
+	UE_LOG(LogClimbReplay, Display, TEXT("Trajectory max location error %.3f, max rotation error %.3f degrees"), MaxLocationError, MaxRotationError);
+	bMatches &= FirstDivergentFrame == INDEX_NONE;
+
+	const int32 FrameTolerance = CVarClimbReplayFrameTolerance.GetValueOnGameThread();
+	const auto CompareTimelines = [FrameTolerance](const TCHAR* TimelineName, const TArray<FClimbReplayTimelineEntry>& Expected,
+		const TArray<FClimbReplayTimelineEntry>& Actual)
+	{
+		for (int32 Index = 0; Index < FMath::Max(Expected.Num(), Actual.Num()); ++Index)
+		{
+			const FClimbReplayTimelineEntry* ExpectedEntry = Expected.IsValidIndex(Index) ? &Expected[Index] : nullptr;
+			const FClimbReplayTimelineEntry* ActualEntry = Actual.IsValidIndex(Index) ? &Actual[Index] : nullptr;
+			if (ExpectedEntry == nullptr || ActualEntry == nullptr || ExpectedEntry->Name != ActualEntry->Name ||
+				FMath::Abs(ExpectedEntry->Frame - ActualEntry->Frame) > FrameTolerance)
+			{
+				UE_LOG(LogClimbReplay, Error, TEXT("%s timeline differs at change %d: %s at frame %d instead of %s at frame %d"), TimelineName, Index,
+					ActualEntry != nullptr ? *ActualEntry->Name : TEXT("nothing"), ActualEntry != nullptr ? ActualEntry->Frame : -1,
+					ExpectedEntry != nullptr ? *ExpectedEntry->Name : TEXT("nothing"), ExpectedEntry != nullptr ? ExpectedEntry->Frame : -1);
+				return false;
+			}
+		}
+		return true;
+	};
+
+	bMatches &= CompareTimelines(TEXT("Movement mode"), Golden.MovementModes, Result.MovementModes);
+	bMatches &= CompareTimelines(TEXT("Montage"), Golden.Montages, Result.Montages);
+	return bMatches;
+}
+
+FString UClimbReplaySubsystem::GetMovementModeName() const
+{
+	const UClimbForgeMovementComponent* MovementComponent = Character->GetClimbForgeMovementComponent();
+	if (MovementComponent->MovementMode == MOVE_Custom)
+	{
+		return StaticEnum<ECustomMovementMode>()->GetNameStringByValue(MovementComponent->CustomMovementMode);
+	}
+	return StaticEnum<EMovementMode>()->GetNameStringByValue(MovementComponent->MovementMode);
+}
@@ -0,0 +1,178 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbReplicatedState.h"
+
+#include "ClimbForgeStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb State Bits Sent"), STAT_ClimbStateBitsSent, STATGROUP_ClimbForge);
+
+namespace
+{
+	constexpr int32 NormalAxisBits = 12;
+	constexpr uint32 NormalAxisMax = (1u << NormalAxisBits) - 1;
+
+	// The climb surface is always within reach of the capsule, +-511 cm.
+	constexpr int32 SurfaceOffsetBits = 10;
+	// The ledge target is at most a capsule height and a bit away, +-2047 cm.
+	constexpr int32 LedgeOffsetBits = 12;
+	constexpr int32 DirectionBits = 3;
+
+	FORCEINLINE uint32 QuantizeUnit(const float Value)
+	{
+		return static_cast<uint32>(FMath::RoundToInt((FMath::Clamp(Value, -1.0f, 1.0f) * 0.5f + 0.5f) * NormalAxisMax));
+	}
+
+	FORCEINLINE float DequantizeUnit(const uint32 Value)
+	{
+		return (static_cast<float>(Value) / NormalAxisMax) * 2.0f - 1.0f;
+	}
+
+	// Octahedral encoding: project the unit sphere onto an octahedron and unfold it into a square.
+	// Gives an even error over the whole sphere with two numbers instead of three.
+	// A packed value of 0 is used for "no surface". It would decode to straight down, which is never a climbable wall.
+	uint32 PackNormal(const FVector& Normal)
+	{
+		const float L1 = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+		if (L1 <= UE_SMALL_NUMBER) return 0;
+
+		float U = Normal.X / L1;
+		float V = Normal.Y / L1;
+		if (Normal.Z < 0.0f)
+		{
+			const float FoldedU = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+			const float FoldedV = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+			U = FoldedU;
+			V = FoldedV;
+		}
+		return (QuantizeUnit(U) << NormalAxisBits) | QuantizeUnit(V);
+	}
+
+	FVector UnpackNormal(const uint32 Packed)
+	{
+		if (Packed == 0) return FVector::ZeroVector;
+
+		const float U = DequantizeUnit((Packed >> NormalAxisBits) & NormalAxisMax);
+		const float V = DequantizeUnit(Packed & NormalAxisMax);
+
+		FVector Normal(U, V, 1.0f - FMath::Abs(U) - FMath::Abs(V));
+		if (Normal.Z < 0.0f)
+		{
+			const float UnfoldedX = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+			const float UnfoldedY = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+			Normal.X = UnfoldedX;
+			Normal.Y = UnfoldedY;
+		}
+		return Normal.GetSafeNormal();
+	}
+
+	FIntVector QuantizeOffset(const FVector& Offset, const int32 NumBits)
+	{
+		const int32 Limit = (1 << (NumBits - 1)) - 1;
+		return FIntVector(
+			FMath::Clamp(FMath::RoundToInt(Offset.X), -Limit, Limit),
+			FMath::Clamp(FMath::RoundToInt(Offset.Y), -Limit, Limit),
+			FMath::Clamp(FMath::RoundToInt(Offset.Z), -Limit, Limit));
+	}
+
+	// Signed components are sent biased so they fit NumBits unsigned bits.
+	void SerializeOffset(FArchive& Ar, FIntVector& Offset, const int32 NumBits)
+	{
+		const int32 Bias = 1 << (NumBits - 1);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			uint32 Biased = static_cast<uint32>(Offset[Axis] + Bias);
+			Ar.SerializeBits(&Biased, NumBits);
+			Offset[Axis] = static_cast<int32>(Biased) - Bias;
+		}
+	}
+}
+
+void FClimbReplicatedState::SetSurface(const FVector& InNormal, const FVector& InLocation, const FVector& InPawnLocation)
+{
+	PackedSurfaceNormal = PackNormal(InNormal);
+	SurfaceLocationOffset = QuantizeOffset(InLocation - InPawnLocation, SurfaceOffsetBits);
+}
+
+void FClimbReplicatedState::SetLedgeTarget(const FVector& InLedgeTarget, const FVector& InPawnLocation)
+{
+	// A clamped offset would point the proxies at the wrong ledge, sending none is better.
+	const int32 Limit = (1 << (LedgeOffsetBits - 1)) - 1;
+	const FVector Offset = InLedgeTarget - InPawnLocation;
+	if (Offset.GetAbsMax() > Limit)
+	{
+		ClearLedgeTarget();
+		return;
+	}
+	bHasLedgeTarget = true;
+	LedgeTargetOffset = QuantizeOffset(Offset, LedgeOffsetBits);
+}
+
+void FClimbReplicatedState::ClearLedgeTarget()
+{
+	bHasLedgeTarget = false;
+	LedgeTargetOffset = FIntVector::ZeroValue;
+}
+
+FVector FClimbReplicatedState::GetSurfaceNormal() const
+{
+	return UnpackNormal(PackedSurfaceNormal);
+}
+
+FVector FClimbReplicatedState::GetSurfaceLocation(const FVector& InPawnLocation) const
+{
+	return InPawnLocation + FVector(SurfaceLocationOffset);
+}
+
+FVector FClimbReplicatedState::GetLedgeTarget(const FVector& InPawnLocation) const
+{
+	return InPawnLocation + FVector(LedgeTargetOffset);
+}
+
+bool FClimbReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// A zero normal means the climber is not on a wall and nothing else is worth sending.
+	uint8 bHasSurface = PackedSurfaceNormal != 0 ? 1 : 0;
+	Ar.SerializeBits(&bHasSurface, 1);
+	if (bHasSurface)
+	{
+		Ar.SerializeBits(&PackedSurfaceNormal, 2 * NormalAxisBits);
+		SerializeOffset(Ar, SurfaceLocationOffset, SurfaceOffsetBits);
+	}
+	else
+	{
+		PackedSurfaceNormal = 0;
+		SurfaceLocationOffset = FIntVector::ZeroValue;
+	}
+
+	uint8 bLedgeTarget = bHasLedgeTarget ? 1 : 0;
+	Ar.SerializeBits(&bLedgeTarget, 1);
+	bHasLedgeTarget = bLedgeTarget != 0;
+	if (bHasLedgeTarget)
+	{
+		SerializeOffset(Ar, LedgeTargetOffset, LedgeOffsetBits);
+	}
+	else
+	{
+		LedgeTargetOffset = FIntVector::ZeroValue;
+	}
+
+	uint8 Direction = static_cast<uint8>(DashDirection);
+	Ar.SerializeBits(&Direction, DirectionBits);
+	DashDirection = static_cast<EClimbingDirection>(FMath::Min<uint8>(Direction, static_cast<uint8>(EClimbingDirection::Right)));
+
+	uint8 bMoveToTarget = bMoveToTargetAfterClimb ? 1 : 0;
+	Ar.SerializeBits(&bMoveToTarget, 1);
+	bMoveToTargetAfterClimb = bMoveToTarget != 0;
+
+	if (Ar.IsSaving())
+	{
+		const uint32 NumBits = 1 + (bHasSurface ? 2 * NormalAxisBits + 3 * SurfaceOffsetBits : 0) + 1 + (bHasLedgeTarget ? 3 * LedgeOffsetBits : 0) +
+			DirectionBits + 1;
+		INC_DWORD_STAT_BY(STAT_ClimbStateBitsSent, NumBits);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
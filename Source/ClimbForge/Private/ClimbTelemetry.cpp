@@ -0,0 +1,202 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbTelemetry.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbTelemetry, Log, All);
+
+const TCHAR* LexToString(const EClimbStopReason Reason)
+{
+	switch (Reason)
+	{
+		case EClimbStopReason::LetGo:				return TEXT("LetGo");
+		case EClimbStopReason::NoSurface:			return TEXT("NoSurface");
+		case EClimbStopReason::UnclimbableSurface:	return TEXT("UnclimbableSurface");
+		case EClimbStopReason::ReachedFloor:		return TEXT("ReachedFloor");
+		case EClimbStopReason::LostLedge:			return TEXT("LostLedge");
+		default:									return TEXT("");
+	}
+}
+
+const TCHAR* LexToString(const EClimbVaultFailReason Reason)
+{
+	switch (Reason)
+	{
+		case EClimbVaultFailReason::Falling:			return TEXT("Falling");
+		case EClimbVaultFailReason::NoObstacle:			return TEXT("NoObstacle");
+		case EClimbVaultFailReason::ObstacleTooHigh:	return TEXT("ObstacleTooHigh");
+		case EClimbVaultFailReason::NoLanding:			return TEXT("NoLanding");
+		case EClimbVaultFailReason::Busy:				return TEXT("Busy");
+		default:										return TEXT("");
+	}
+}
+
+const TCHAR* LexToString(const EClimbDashFailReason Reason)
+{
+	switch (Reason)
+	{
+		case EClimbDashFailReason::InvalidDirection:	return TEXT("InvalidDirection");
+		case EClimbDashFailReason::NoTarget:			return TEXT("NoTarget");
+		case EClimbDashFailReason::Busy:				return TEXT("Busy");
+		default:										return TEXT("");
+	}
+}
+
+#if CLIMBFORGE_WITH_TELEMETRY
+
+#include <atomic>
+
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Events kept per thread. Must be a power of two.
+	constexpr uint32 ClimbTelemetryCapacity = 4096;
+
+	// Written by its own thread only, so recording needs no lock. The dump reads it from the game thread.
+	struct FClimbTelemetryRing
+	{
+		uint32 ThreadId = 0;
+		std::atomic<uint32> NumWritten { 0 };
+		FClimbTelemetryEvent Events[ClimbTelemetryCapacity];
+	};
+
+	// Rings outlive their threads so the events of finished threads can still be dumped.
+	FCriticalSection RingsLock;
+	TArray<TUniquePtr<FClimbTelemetryRing>> Rings;
+
+	FClimbTelemetryRing& GetThreadRing()
+	{
+		thread_local FClimbTelemetryRing* ThreadRing = nullptr;
+		if (ThreadRing == nullptr)
+		{
+			TUniquePtr<FClimbTelemetryRing> NewRing = MakeUnique<FClimbTelemetryRing>();
+			NewRing->ThreadId = FPlatformTLS::GetCurrentThreadId();
+			ThreadRing = NewRing.Get();
+
+			FScopeLock Lock(&RingsLock);
+			Rings.Add(MoveTemp(NewRing));
+		}
+		return *ThreadRing;
+	}
+
+	const TCHAR* GetEventTypeName(const EClimbTelemetryEventType Type)
+	{
+		switch (Type)
+		{
+			case EClimbTelemetryEventType::ClimbStart:	return TEXT("ClimbStart");
+			case EClimbTelemetryEventType::ClimbStop:	return TEXT("ClimbStop");
+			case EClimbTelemetryEventType::VaultStart:	return TEXT("VaultStart");
+			case EClimbTelemetryEventType::VaultFail:	return TEXT("VaultFail");
+			case EClimbTelemetryEventType::DashStart:	return TEXT("DashStart");
+			case EClimbTelemetryEventType::DashFail:	return TEXT("DashFail");
+			default:									return TEXT("Unknown");
+		}
+	}
+
+	const TCHAR* GetReasonName(const EClimbTelemetryEventType Type, const uint8 Reason)
+	{
+		switch (Type)
+		{
+			case EClimbTelemetryEventType::ClimbStop:
+				return LexToString(static_cast<EClimbStopReason>(Reason));
+
+			case EClimbTelemetryEventType::VaultFail:
+				return LexToString(static_cast<EClimbVaultFailReason>(Reason));
+
+			case EClimbTelemetryEventType::DashFail:
+				return LexToString(static_cast<EClimbDashFailReason>(Reason));
+
+			default:
+				return TEXT("");
+		}
+	}
+
+	FAutoConsoleCommand CVarDumpClimbTelemetry(
+		TEXT("ClimbForge.DumpTelemetry"),
+		TEXT("Writes the recorded climb events to a CSV file. Usage: ClimbForge.DumpTelemetry [FilePath]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString FilePath = Args.Num() > 0 ? Args[0] :
+				FPaths::ProjectSavedDir() / TEXT("Telemetry") / FString::Printf(TEXT("ClimbTelemetry-%s.csv"), *FDateTime::Now().ToString());
+			ClimbTelemetry::DumpToCSV(FilePath);
+		}));
+}
+
+void ClimbTelemetry::RecordEvent(const EClimbTelemetryEventType Type, const AActor* Actor, const uint8 Reason, const EClimbingDirection Direction)
+{
+	FClimbTelemetryRing& Ring = GetThreadRing();
+	const uint32 Index = Ring.NumWritten.load(std::memory_order_relaxed);
+
+	FClimbTelemetryEvent& Event = Ring.Events[Index & (ClimbTelemetryCapacity - 1)];
+	Event.Time = FPlatformTime::Seconds();
+	Event.Frame = GFrameCounter;
+	Event.Location = Actor != nullptr ? FVector3f(Actor->GetActorLocation()) : FVector3f::ZeroVector;
+	Event.ActorId = Actor != nullptr ? Actor->GetUniqueID() : 0;
+	Event.Type = Type;
+	Event.Reason = Reason;
+	Event.Direction = Direction;
+
+	Ring.NumWritten.store(Index + 1, std::memory_order_release);
+}
+
+bool ClimbTelemetry::DumpToCSV(const FString& FilePath)
+{
+	TArray<TPair<uint32, FClimbTelemetryEvent>> AllEvents;
+	{
+		FScopeLock Lock(&RingsLock);
+		for (const TUniquePtr<FClimbTelemetryRing>& Ring : Rings)
+		{
+			// Events written while this runs may be torn at the wrap point, acceptable for playtest statistics.
+			const uint32 NumWritten = Ring->NumWritten.load(std::memory_order_acquire);
+			const uint32 First = NumWritten > ClimbTelemetryCapacity ? NumWritten - ClimbTelemetryCapacity : 0;
+			for (uint32 Index = First; Index < NumWritten; ++Index)
+			{
+				AllEvents.Emplace(Ring->ThreadId, Ring->Events[Index & (ClimbTelemetryCapacity - 1)]);
+			}
+		}
+	}
+
+	AllEvents.Sort([](const TPair<uint32, FClimbTelemetryEvent>& A, const TPair<uint32, FClimbTelemetryEvent>& B)
+	{
+		return A.Value.Time < B.Value.Time;
+	});
+
+	const UEnum* DirectionEnum = StaticEnum<EClimbingDirection>();
+	uint32 NumPerType[static_cast<uint8>(EClimbTelemetryEventType::DashFail) + 1] = {};
+
+	FString CSV = TEXT("Time,Frame,Thread,Actor,Event,Reason,Direction,X,Y,Z\n");
+	for (const TPair<uint32, FClimbTelemetryEvent>& Entry : AllEvents)
+	{
+		const FClimbTelemetryEvent& Event = Entry.Value;
+		++NumPerType[static_cast<uint8>(Event.Type)];
+
+		CSV += FString::Printf(TEXT("%.4f,%llu,%u,%u,%s,%s,%s,%.1f,%.1f,%.1f\n"), Event.Time, Event.Frame, Entry.Key, Event.ActorId,
+			GetEventTypeName(Event.Type), GetReasonName(Event.Type, Event.Reason),
+			*DirectionEnum->GetNameStringByValue(static_cast<int64>(Event.Direction)), Event.Location.X, Event.Location.Y, Event.Location.Z);
+	}
+
+	if (!FFileHelper::SaveStringToFile(CSV, *FilePath))
+	{
+		UE_LOG(LogClimbTelemetry, Warning, TEXT("Failed to write climb telemetry to %s"), *FilePath);
+		return false;
+	}
+
+	const auto GetFailRate = [&NumPerType](const EClimbTelemetryEventType Start, const EClimbTelemetryEventType Fail)
+	{
+		const uint32 Attempts = NumPerType[static_cast<uint8>(Start)] + NumPerType[static_cast<uint8>(Fail)];
+		return Attempts > 0 ? 100.0f * NumPerType[static_cast<uint8>(Fail)] / Attempts : 0.0f;
+	};
+
+	UE_LOG(LogClimbTelemetry, Display, TEXT("Wrote %d climb events to %s. Vault fail rate %.1f%%, dash fail rate %.1f%%"), AllEvents.Num(), *FilePath,
+		GetFailRate(EClimbTelemetryEventType::VaultStart, EClimbTelemetryEventType::VaultFail),
+		GetFailRate(EClimbTelemetryEventType::DashStart, EClimbTelemetryEventType::DashFail));
+	return true;
+}
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbTraversalLayeredMove.h"
+
+#include "MoverDataModelTypes.h"
+#include "MoverSimulationTypes.h"
+#include "MoverTypes.h"
+
+FLayeredMove_ClimbTraversal::FLayeredMove_ClimbTraversal()
+{
+	MixMode = EMoveMixMode::OverrideVelocity;
+}
+
+FVector FLayeredMove_ClimbTraversal::GetPointAt(const float Alpha) const
+{
+	const float InverseAlpha = 1.0f - Alpha;
+	return InverseAlpha * InverseAlpha * Start + 2.0f * InverseAlpha * Alpha * Control + Alpha * Alpha * Target;
+}
+
+bool FLayeredMove_ClimbTraversal::GenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep,
+	const UMoverComponent* MoverComp, UMoverBlackboard* SimBlackboard, FProposedMove& OutProposedMove)
+{
+	const FMoverDefaultSyncState* SyncState = StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	const float DeltaSeconds = TimeStep.StepMs * 0.001f;
+	if (SyncState == nullptr || DeltaSeconds <= 0.0f || DurationMs <= 0.0f) return false;
+
+	// Head for where the path is at the end of this step instead of following its slope, so a step that was blocked
+	// or cut short is caught up on the next one.
+	const float Alpha = FMath::Clamp((TimeStep.BaseSimTimeMs + TimeStep.StepMs - StartSimTimeMs) / DurationMs, 0.0f, 1.0f);
+	OutProposedMove.MixMode = MixMode;
+	OutProposedMove.LinearVelocity = (GetPointAt(Alpha) - SyncState->GetLocation_WorldSpace()) / DeltaSeconds;
+	OutProposedMove.PreferredMode = Alpha < 1.0f ? FName(DefaultModeNames::Flying) : ModeAfterTraversal;
+	return true;
+}
+
+FLayeredMoveBase* FLayeredMove_ClimbTraversal::Clone() const
+{
+	return new FLayeredMove_ClimbTraversal(*this);
+}
+
+void FLayeredMove_ClimbTraversal::NetSerialize(FArchive& Ar)
+{
+	Super::NetSerialize(Ar);
+
+	Ar << Start;
+	Ar << Control;
+	Ar << Target;
+	Ar << ModeAfterTraversal;
+}
+
+UScriptStruct* FLayeredMove_ClimbTraversal::GetScriptStruct() const
+{
+	return FLayeredMove_ClimbTraversal::StaticStruct();
+}
+
+FString FLayeredMove_ClimbTraversal::ToSimpleString()
+{
+	return FString::Printf(TEXT("ClimbTraversal to %s then %s"), *Target.ToCompactString(), *ModeAfterTraversal.ToString());
+}
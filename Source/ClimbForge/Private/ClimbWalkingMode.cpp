@@ -0,0 +1,76 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbWalkingMode.h"
+
+#include "ClimbingMode.h"
+#include "ClimbMoverInputs.h"
+#include "ClimbMoverSettings.h"
+#include "ClimbTraversalLayeredMove.h"
+#include "MoverComponent.h"
+#include "MoverDataModelTypes.h"
+#include "MoverTypes.h"
+#include "DefaultMovementSet/Settings/CommonLegacyMovementSettings.h"
+
+UClimbWalkingMode::UClimbWalkingMode(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	SharedSettingsClasses.Add(UClimbMoverSettings::StaticClass());
+}
+
+void UClimbWalkingMode::OnRegistered(const FName ModeName)
+{
+	Super::OnRegistered(ModeName);
+
+	ClimbSettings = GetMoverComponent()->FindSharedSettings<UClimbMoverSettings>();
+	WalkSettings = GetMoverComponent()->FindSharedSettings<UCommonLegacyMovementSettings>();
+	ensureMsgf(ClimbSettings, TEXT("Failed to find an instance of UClimbMoverSettings on %s. Climbing will not function."),
+		*GetPathNameSafe(GetMoverComponent()));
+}
+
+void UClimbWalkingMode::OnUnregistered()
+{
+	ClimbSettings = nullptr;
+	WalkSettings = nullptr;
+
+	Super::OnUnregistered();
+}
+
+void UClimbWalkingMode::OnSimulationTick(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+	Super::OnSimulationTick(Params, OutputState);
+
+	const FClimbMoverInputs* ClimbInputs = Params.StartState.InputCmd.InputCollection.FindDataByType<FClimbMoverInputs>();
+	if (ClimbInputs == nullptr || (!ClimbInputs->bWantsToClimb && !ClimbInputs->bWantsToVault)) return;
+
+	// Still walking at the end of the step, the walk may have stepped off a ledge already.
+	const UPrimitiveComponent* UpdatedPrimitive = Params.MovingComps.UpdatedPrimitive.Get();
+	const FMoverDefaultSyncState* OutputSyncState = OutputState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	if (UpdatedPrimitive == nullptr || OutputSyncState == nullptr || ClimbSettings == nullptr || !OutputState.MovementEndState.NextModeName.IsNone()) return;
+
+	const FVector Location = OutputSyncState->GetLocation_WorldSpace();
+	const FQuat Orientation = OutputSyncState->GetOrientation_WorldSpace().Quaternion();
+
+	if (ClimbInputs->bWantsToClimb && UClimbMoverLibrary::CanStartClimbing(*UpdatedPrimitive, *ClimbSettings, Location, Orientation, Scratch))
+	{
+		OutputState.MovementEndState.NextModeName = ClimbModeNames::Climbing;
+		return;
+	}
+
+	if (ClimbInputs->bWantsToVault)
+	{
+		const float SpeedRatio = WalkSettings != nullptr && WalkSettings->MaxSpeed > 0.0f ?
+			FMath::Min(1.0f, static_cast<float>(OutputSyncState->GetVelocity_WorldSpace().Size()) / WalkSettings->MaxSpeed) : 1.0f;
+
+		FVector Control;
+		FVector Target;
+		if (UClimbMoverLibrary::FindVault(*UpdatedPrimitive, *ClimbSettings, Location, Orientation, SpeedRatio, Control, Target))
+		{
+			// Like the ledge climb of UClimbingMode, the pawn flies until the traversal takes over on the next step.
+			OutputState.SyncState.LayeredMoves.QueueLayeredMove(UClimbMoverLibrary::MakeTraversal(Location, Control, Target,
+				ClimbSettings->VaultDuration, DefaultModeNames::Falling));
+			OutputState.MovementEndState.NextModeName = DefaultModeNames::Flying;
+		}
+	}
+}
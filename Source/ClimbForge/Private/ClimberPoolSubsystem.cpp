@@ -0,0 +1,90 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimberPoolSubsystem.h"
+
+#include "ClimbForgeCharacter.h"
+#include "ClimbForgeStats.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climber Pool Acquire"), STAT_ClimberPoolAcquire, STATGROUP_ClimbForge);
+DECLARE_CYCLE_STAT(TEXT("Climber Pool Release"), STAT_ClimberPoolRelease, STATGROUP_ClimbForge);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Climber Pool Free"), STAT_ClimberPoolFree, STATGROUP_ClimbForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climber Pool Spawns"), STAT_ClimberPoolSpawns, STATGROUP_ClimbForge);
+
+void UClimberPoolSubsystem::Prewarm(TSubclassOf<AClimbForgeCharacter> ClimberClass, const int32 Count)
+{
+	if (ClimberClass == nullptr) return;
+
+	FClimberPool& Pool = Pools.FindOrAdd(ClimberClass);
+	Pool.FreeClimbers.Reserve(Pool.FreeClimbers.Num() + Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (AClimbForgeCharacter* Climber = SpawnClimber(ClimberClass, FTransform::Identity))
+		{
+			Climber->DeactivateForPool();
+			Pool.FreeClimbers.Add(Climber);
+			INC_DWORD_STAT(STAT_ClimberPoolFree);
+		}
+	}
+}
+
+AClimbForgeCharacter* UClimberPoolSubsystem::AcquireClimber(TSubclassOf<AClimbForgeCharacter> ClimberClass, const FTransform& SpawnTransform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimberPoolAcquire);
+	if (ClimberClass == nullptr) return nullptr;
+
+	if (FClimberPool* Pool = Pools.Find(ClimberClass))
+	{
+		while (!Pool->FreeClimbers.IsEmpty())
+		{
+			AClimbForgeCharacter* Climber = Pool->FreeClimbers.Pop(EAllowShrinking::No);
+			DEC_DWORD_STAT(STAT_ClimberPoolFree);
+
+			// Something outside of the pool may have destroyed it in the meantime.
+			if (IsValid(Climber))
+			{
+				Climber->ActivateFromPool(SpawnTransform);
+				return Climber;
+			}
+		}
+	}
+
+	return SpawnClimber(ClimberClass, SpawnTransform);
+}
+
+void UClimberPoolSubsystem::ReleaseClimber(AClimbForgeCharacter* Climber)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimberPoolRelease);
+	if (!IsValid(Climber) || Climber->IsInPool()) return;
+
+	Climber->DeactivateForPool();
+	Pools.FindOrAdd(Climber->GetClass()).FreeClimbers.Add(Climber);
+	INC_DWORD_STAT(STAT_ClimberPoolFree);
+}
+
+int32 UClimberPoolSubsystem::GetNumFreeClimbers(TSubclassOf<AClimbForgeCharacter> ClimberClass) const
+{
+	const FClimberPool* Pool = Pools.Find(ClimberClass);
+	return Pool != nullptr ? Pool->FreeClimbers.Num() : 0;
+}
+
+void UClimberPoolSubsystem::Deinitialize()
+{
+	for (const TPair<TSubclassOf<AClimbForgeCharacter>, FClimberPool>& Pair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_ClimberPoolFree, Pair.Value.FreeClimbers.Num());
+	}
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+AClimbForgeCharacter* UClimberPoolSubsystem::SpawnClimber(TSubclassOf<AClimbForgeCharacter> ClimberClass, const FTransform& SpawnTransform) const
+{
+	INC_DWORD_STAT(STAT_ClimberPoolSpawns);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	return GetWorld()->SpawnActor<AClimbForgeCharacter>(ClimberClass, SpawnTransform, SpawnParameters);
+}
@@ -0,0 +1,167 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbingMode.h"
+
+#include "ClimbForgeStats.h"
+#include "ClimbMoverInputs.h"
+#include "ClimbMoverLibrary.h"
+#include "ClimbMoverSettings.h"
+#include "ClimbTraversalLayeredMove.h"
+#include "MoverComponent.h"
+#include "MoverDataModelTypes.h"
+#include "MoverTypes.h"
+#include "DefaultMovementSet/Settings/CommonLegacyMovementSettings.h"
+#include "MoveLibrary/MovementUtils.h"
+
+// The counterpart of Climb Step, the contacts sweep and summary are timed apart like they are for the movement component.
+DECLARE_CYCLE_STAT(TEXT("Climb Mover Step"), STAT_ClimbMoverStep, STATGROUP_ClimbForge);
+
+UClimbingMode::UClimbingMode(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	SharedSettingsClasses.Add(UClimbMoverSettings::StaticClass());
+	SharedSettingsClasses.Add(UCommonLegacyMovementSettings::StaticClass());
+}
+
+void UClimbingMode::OnRegistered(const FName ModeName)
+{
+	Super::OnRegistered(ModeName);
+
+	ClimbSettings = GetMoverComponent()->FindSharedSettings<UClimbMoverSettings>();
+	CommonLegacySettings = GetMoverComponent()->FindSharedSettings<UCommonLegacyMovementSettings>();
+	ensureMsgf(ClimbSettings, TEXT("Failed to find an instance of UClimbMoverSettings on %s. Climbing will not function."),
+		*GetPathNameSafe(GetMoverComponent()));
+}
+
+void UClimbingMode::OnUnregistered()
+{
+	ClimbSettings = nullptr;
+	CommonLegacySettings = nullptr;
+
+	Super::OnUnregistered();
+}
+
+void UClimbingMode::OnGenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const
+{
+	const FMoverDefaultSyncState* SyncState = StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	if (SyncState == nullptr || ClimbSettings == nullptr) return;
+
+	const FCharacterDefaultInputs* Inputs = StartState.InputCmd.InputCollection.FindDataByType<FCharacterDefaultInputs>();
+	const FVector Stick = Inputs != nullptr ? Inputs->GetMoveInput() : FVector::ZeroVector;
+
+	// The climber faces the surface, so its up and right vectors lie in the surface like the character's climbing input directions do.
+	const FQuat Orientation = SyncState->GetOrientation_WorldSpace().Quaternion();
+	const FVector Intent = (Orientation.GetUpVector() * Stick.Y + Orientation.GetRightVector() * Stick.X).GetClampedToMaxSize(1.0f);
+
+	const float DeltaSeconds = TimeStep.StepMs * 0.001f;
+	const float Rate = Intent.IsNearlyZero() ? ClimbSettings->MaxBrakeClimbDeceleration : ClimbSettings->MaxClimbAcceleration;
+	OutProposedMove.LinearVelocity = FMath::VInterpConstantTo(SyncState->GetVelocity_WorldSpace(), Intent * ClimbSettings->MaxClimbSpeed,
+		DeltaSeconds, Rate);
+	OutProposedMove.bHasDirIntent = !Intent.IsNearlyZero();
+	OutProposedMove.DirectionIntent = Intent;
+}
+
+void UClimbingMode::OnSimulationTick(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+	const FMoverDefaultSyncState* StartingSyncState = Params.StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	check(StartingSyncState);
+	FMoverDefaultSyncState& OutputSyncState = OutputState.SyncState.SyncStateCollection.FindOrAddMutableDataByType<FMoverDefaultSyncState>();
+
+	const FVector StartLocation = StartingSyncState->GetLocation_WorldSpace();
+	const FQuat StartOrientation = StartingSyncState->GetOrientation_WorldSpace().Quaternion();
+
+	// Unless the climber moves below, it ends the step where it started and hands all of it to the next mode.
+	OutputSyncState.SetTransforms_WorldSpace(StartLocation, StartOrientation.Rotator(), StartingSyncState->GetVelocity_WorldSpace(),
+		StartingSyncState->GetMovementBase(), StartingSyncState->GetMovementBaseBoneName());
+	OutputState.MovementEndState.RemainingMs = Params.TimeStep.StepMs;
+
+	USceneComponent* UpdatedComponent = Params.MovingComps.UpdatedComponent.Get();
+	const UPrimitiveComponent* UpdatedPrimitive = Params.MovingComps.UpdatedPrimitive.Get();
+	const float DeltaSeconds = Params.TimeStep.StepMs * 0.001f;
+	if (UpdatedComponent == nullptr || UpdatedPrimitive == nullptr || ClimbSettings == nullptr || DeltaSeconds <= 0.0f) return;
+
+	const FClimbMoverInputs* ClimbInputs = Params.StartState.InputCmd.InputCollection.FindDataByType<FClimbMoverInputs>();
+	if (ClimbInputs != nullptr && ClimbInputs->bWantsToLetGo)
+	{
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Falling;
+		return;
+	}
+
+	// The dash is a traversal that goes into the output sync state, like the ledge climb below.
+	FVector DashTarget;
+	if (ClimbInputs != nullptr && UClimbMoverLibrary::FindClimbDash(*UpdatedPrimitive, *ClimbSettings, StartLocation, StartOrientation,
+		ClimbInputs->DashDirection, DashTarget))
+	{
+		OutputState.SyncState.LayeredMoves.QueueLayeredMove(UClimbMoverLibrary::MakeTraversal(StartLocation, (StartLocation + DashTarget) * 0.5f,
+			DashTarget, ClimbSettings->ClimbDashDuration, ClimbModeNames::Climbing));
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Flying;
+		return;
+	}
+
+	FClimbMoverSurface Surface;
+	if (!UClimbMoverLibrary::FindClimbableSurface(*UpdatedPrimitive, *ClimbSettings, StartLocation, StartOrientation, Scratch, Surface))
+	{
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Falling;
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ClimbMoverStep);
+
+	const FVector ProposedVelocity = Params.ProposedMove.LinearVelocity;
+	const FVector Up = StartOrientation.GetUpVector();
+
+	// Only when climbing down, the floor is next to the climber when it starts climbing up too.
+	if (FVector::DotProduct(ProposedVelocity, Up) < -10.0f &&
+		UClimbMoverLibrary::IsOnFloor(*UpdatedPrimitive, *ClimbSettings, StartLocation, StartOrientation, Scratch))
+	{
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Walking;
+		return;
+	}
+
+	// Move along the surface while turning to face it.
+	const FQuat NewOrientation = FMath::QInterpTo(StartOrientation, ClimbMath::GetSurfaceFacingRotation(Surface.Normal), DeltaSeconds, 5.0f);
+	const FVector Delta = ProposedVelocity * DeltaSeconds;
+
+	FMovementRecord MoveRecord;
+	MoveRecord.SetDeltaSeconds(DeltaSeconds);
+
+	FHitResult Hit(1.0f);
+	UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, Delta, NewOrientation, true, Hit, ETeleportType::None, MoveRecord);
+	if (Hit.IsValidBlockingHit())
+	{
+		UMovementUtils::TryMoveToSlideAlongSurface(Params.MovingComps, Delta, 1.0f - Hit.Time, NewOrientation, Hit.Normal, Hit, true, MoveRecord);
+	}
+
+	const FVector NewVelocity = (UpdatedComponent->GetComponentLocation() - StartLocation) / DeltaSeconds;
+
+	// Pull back onto the surface like UClimbForgeMovementComponent::SnapToClimbableSurface does. Not part of the velocity.
+	const FVector SnapVector = ClimbMath::GetSnapVector(UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetForwardVector(),
+		Surface.Location, Surface.Normal);
+	FHitResult SnapHit(1.0f);
+	UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, SnapVector * DeltaSeconds * ClimbSettings->MaxClimbSpeed, NewOrientation, true,
+		SnapHit, ETeleportType::None, MoveRecord);
+
+	// Ride along with walls that move.
+	UPrimitiveComponent* MovementBase = Surface.Component != nullptr && Surface.Component->Mobility == EComponentMobility::Movable ?
+		Surface.Component : nullptr;
+	OutputSyncState.SetTransforms_WorldSpace(UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentRotation(), NewVelocity,
+		MovementBase);
+	OutputState.MovementEndState.RemainingMs = 0.0f;
+
+	// Climbed to the top, go over the ledge. The climber flies until the traversal takes over on the next step. The traversal goes
+	// into the sync state this step outputs, queueing it on the mover component from inside the simulation would skip rollback.
+	const float WalkableFloorZ = CommonLegacySettings != nullptr ? CommonLegacySettings->MaxWalkSlopeCosine : 0.71f;
+	FVector StandLocation;
+	if (FVector::DotProduct(ProposedVelocity, Up) > 10.0f && UClimbMoverLibrary::FindLedgeTop(*UpdatedPrimitive, *ClimbSettings,
+		UpdatedComponent->GetComponentLocation(), NewOrientation, WalkableFloorZ, StandLocation))
+	{
+		// Straight up to the height of the ledge top first, then over it.
+		const FVector Location = UpdatedComponent->GetComponentLocation();
+		const FVector Control = Location + Up * (FVector::DotProduct(StandLocation - Location, Up) + ClimbSettings->TraversalClearance);
+		OutputState.SyncState.LayeredMoves.QueueLayeredMove(UClimbMoverLibrary::MakeTraversal(Location, Control, StandLocation,
+			ClimbSettings->LedgeClimbDuration, DefaultModeNames::Walking));
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Flying;
+	}
+}
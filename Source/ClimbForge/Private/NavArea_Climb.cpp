@@ -0,0 +1,13 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "NavArea_Climb.h"
+
+UNavArea_Climb::UNavArea_Climb(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	// Climbing is slower than walking, prefer a walkable detour of up to three times the length.
+	DefaultCost = 3.0f;
+	DrawColor = FColor::Orange;
+}
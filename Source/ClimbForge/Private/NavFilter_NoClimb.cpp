@@ -0,0 +1,14 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "NavFilter_NoClimb.h"
+#include "NavArea_Climb.h"
+
+UNavFilter_NoClimb::UNavFilter_NoClimb(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	FNavigationFilterArea& ClimbArea = Areas.AddDefaulted_GetRef();
+	ClimbArea.AreaClass = UNavArea_Climb::StaticClass();
+	ClimbArea.bIsExcluded = true;
+}
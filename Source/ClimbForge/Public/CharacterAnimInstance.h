@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "ClimbLimb.h"
 #include "CharacterAnimInstance.generated.h"
 
 class UClimbForgeMovementComponent;
@@ -48,10 +49,30 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Essential Movement Data", meta=(AllowPrivateAccess=true))
 	bool bIsClimbing;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Essential Movement Data", meta=(AllowPrivateAccess=true))
+	bool bIsHanging;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Essential Movement Data", meta=(AllowPrivateAccess=true))
 	FVector ClimbVelocity;
 
 #pragma endregion
+
+#pragma region Climbing IK Data
+
+	// Limb targets for the CR_ClimbingIK control rig. Generated by the movement component so the rig does not trace.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK Data", meta=(AllowPrivateAccess=true))
+	FClimbLimbTarget LeftHandIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK Data", meta=(AllowPrivateAccess=true))
+	FClimbLimbTarget RightHandIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK Data", meta=(AllowPrivateAccess=true))
+	FClimbLimbTarget LeftFootIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK Data", meta=(AllowPrivateAccess=true))
+	FClimbLimbTarget RightFootIKTarget;
+
+#pragma endregion
 	
 protected:
 #pragma region Overidden Functions
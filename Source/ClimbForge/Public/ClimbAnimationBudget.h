@@ -0,0 +1,51 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimationSharingTypes.h"
+#include "ClimbAnimationBudget.generated.h"
+
+class AClimbForgeCharacter;
+class USkeletalMeshComponentBudgeted;
+
+// Climb states whose animation is a loop that any number of far away climbers can share.
+UENUM(BlueprintType)
+enum class EClimbAnimationState : uint8
+{
+	// Not on a wall. Climbers are only shared while climbing or hanging.
+	Ground,
+	ClimbIdle,
+	ClimbUp,
+	ClimbDown,
+	ClimbLeft,
+	ClimbRight,
+	HangIdle
+};
+
+namespace ClimbAnimationBudget
+{
+	// The shareable loop the climber is in.
+	CLIMBFORGE_API EClimbAnimationState GetAnimationState(const AClimbForgeCharacter& Climber);
+
+	// Significance for the Animation Budget Allocator: distance to the closest local view, raised for climb transitions, whose root
+	// motion moves the capsule, and lowered for climbers that hang still. The allocator is enabled and budgeted with the a.Budget.*
+	// cvars in DefaultEngine.ini.
+	CLIMBFORGE_API float CalculateSignificance(USkeletalMeshComponentBudgeted* Component);
+}
+
+/**
+ * Picks the EClimbAnimationState of a climber registered with the animation sharing manager. Set it as the state processor of the
+ * climber skeleton in the UAnimationSharingSetup, with one shared loop per state.
+ */
+UCLASS()
+class CLIMBFORGE_API UClimbAnimationSharingStateProcessor : public UAnimationSharingStateProcessor
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState,
+		bool& bShouldProcess) override;
+	virtual UEnum* GetAnimationStateEnum_Implementation() override;
+};
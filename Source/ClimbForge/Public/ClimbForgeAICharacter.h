@@ -0,0 +1,54 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbForgeCharacter.h"
+#include "ClimbNavigationSubsystem.h"
+#include "ClimbForgeAICharacter.generated.h"
+
+class UNavLinkCustomComponent;
+class UPathFollowingComponent;
+
+/**
+ * Climber driven by an AI controller. Identical to AClimbForgeCharacter except that it never creates the camera boom and
+ * follow camera, which makes it cheaper to spawn and to keep in a UClimberPoolSubsystem.
+ * It also crosses the climb nav links of the UClimbNavigationSubsystem: when its path following reaches one, it climbs the route
+ * FindClimbPath returns for it and then hands the move back.
+ */
+UCLASS()
+class AClimbForgeAICharacter : public AClimbForgeCharacter
+{
+	GENERATED_BODY()
+
+public:
+	AClimbForgeAICharacter(const FObjectInitializer& ObjectInitializer);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	// Climb over the nav link the path following reached. Returns false if there is no climb route to Destination.
+	bool StartClimbNavLink(UNavLinkCustomComponent& Link, UPathFollowingComponent& PathFollowing, const FVector& Destination);
+
+	bool IsOnClimbNavLink() const { return ClimbNavPointIndex != INDEX_NONE; }
+
+protected:
+	/** Distance at which a point of the climb route counts as reached, and at which mounting or vaulting is tried. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation")
+	float ClimbNavAcceptanceRadius = 50.0f;
+
+	/** A climb nav link that isn't crossed within this time is given up, the path following then repaths. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation")
+	float ClimbNavLinkTimeout = 15.0f;
+
+private:
+	TArray<FClimbNavPathPoint> ClimbNavPath;
+	int32 ClimbNavPointIndex = INDEX_NONE;
+	double ClimbNavLinkStartTime = 0.0;
+	TWeakObjectPtr<UNavLinkCustomComponent> ClimbNavLink;
+	TWeakObjectPtr<UPathFollowingComponent> ClimbNavPathFollowing;
+
+	// Move or act toward the current point of the climb route and advance once it is reached.
+	void UpdateClimbNavLink();
+	void FinishClimbNavLink();
+};
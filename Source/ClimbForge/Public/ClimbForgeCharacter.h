@@ -4,8 +4,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ClimbPredictedAction.h"
+#include "ClimbReplicatedState.h"
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
+#include "UObject/ObjectKey.h"
 #include "ClimbForgeCharacter.generated.h"
 
 class UClimbForgeMovementComponent;
@@ -14,7 +17,10 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class UAnimationSharingSetup;
 struct FInputActionValue;
+struct FInputActionInstance;
+enum class EClimbRecordedAction : uint8;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
@@ -32,6 +38,47 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
 
+#pragma region Climbing Camera
+	/** While climbing the boom stops probing every frame and uses the wall the movement component already found */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbingCamera = true;
+
+	/** How far the camera is pushed away from the climbed wall along its normal */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbingCameraWallOffset = 40.0f;
+
+	/** Seconds between occlusion probes while the wall plane does not change */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbingCameraProbeInterval = 0.25f;
+
+	/** The wall plane counts as changed when its normal turns further than this (dot product) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbingCameraPlaneNormalTolerance = 0.995f;
+
+	/** The wall plane counts as changed when it moves further than this along its normal */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbingCameraPlaneDistanceTolerance = 5.0f;
+
+	/** The view counts as changed when the control rotation turns further than this many degrees since the last probe */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbingCameraRotationTolerance = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbingCameraInterpSpeed = 8.0f;
+
+	bool bIsClimbingCameraActive = false;
+	float ClimbingCameraProbeTimer = 0.0f;
+	float ClimbingCameraArmLength = 0.0f;
+	FVector ClimbingCameraWallNormal = FVector::ZeroVector;
+	FQuat ClimbingCameraProbeRotation = FQuat::Identity;
+	float ClimbingCameraWallPlaneDistance = 0.0f;
+
+	// Boom settings to go back to after climbing.
+	float DefaultCameraArmLength = 0.0f;
+	FVector DefaultCameraTargetOffset = FVector::ZeroVector;
+	bool bDefaultCameraDoCollisionTest = true;
+#pragma endregion
+
 #pragma region Input
 	/** MappingContext */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
@@ -61,6 +108,28 @@ private:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UInputAction> ClimbHopAction;
+
+	// Keep the climbing mapping context registered for the whole session and route its actions by the climbing flag instead
+	// of adding and removing it on every mode change (each of which rebuilds the control mappings).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	bool bKeepClimbingMappingContextRegistered = true;
+
+	// ClimbingMappingContext as it is registered for the session, see BuildClimbingInputLayer.
+	UPROPERTY(Transient)
+	TObjectPtr<UInputMappingContext> ClimbingInputLayer;
+
+	// The climbing actions that consume a key the default context also maps, and the copies ClimbingInputLayer maps in their place.
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<const UInputAction>, TObjectPtr<UInputAction>> ClimbingLayerActions;
+
+	// True while the climbing input layer is routed. This is all a mode change touches when the climbing context stays registered.
+	bool bIsClimbingInputActive = false;
+
+	// Whether ClimbingInputLayer is registered, otherwise ClimbingMappingContext is added and removed on every mode change.
+	bool bClimbingMappingContextIsPersistent = false;
+
+	// Set by the UClimbReplaySubsystem while it records this character's input.
+	bool bIsRecordingInput = false;
 	
 #pragma endregion
 
@@ -70,8 +139,87 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Components, meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UMotionWarpingComponent> MotionWarpingComponent;
 	
+	/** True while the character sits in a UClimberPoolSubsystem waiting to be reused */
+	bool bIsInPool = false;
+
+	/** Climb state for simulated proxies. Filled in by the movement component on the authority */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedClimbState)
+	FClimbReplicatedState ReplicatedClimbState;
+
+#pragma region Climb Networking
+	/** AI climbers that hang still on a wall go dormant until they move again. Player climbers stay awake for their move acks */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbDormancy = true;
+
+	/** Seconds a climber has to hang still before it goes dormant */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true", ClampMin = 0.0f))
+	float ClimbDormancyDelay = 2.0f;
+
+	/** Net update frequency of a climber that hangs still. It rises with the climb speed up to MovingClimbNetUpdateFrequency */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true", ClampMin = 1.0f))
+	float IdleClimbNetUpdateFrequency = 2.0f;
+
+	/** Net update frequency at full climb speed. Dashes, vaults and ledge climbs use the actor's own frequency */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true", ClampMin = 1.0f))
+	float MovingClimbNetUpdateFrequency = 30.0f;
+
+	/** A climber further above or below the viewer than this is only relevant while the viewer can see it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true", ClampMin = 0.0f))
+	float ClimbRelevancyVerticalDistance = 1500.0f;
+
+	/** A climber's net priority halves with every this much vertical distance from the viewer. 0 turns it off */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true", ClampMin = 0.0f))
+	float ClimbNetPriorityHalvingHeight = 1000.0f;
+
+	/** Seconds a line of sight check is reused for the same viewer */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Networking", meta = (AllowPrivateAccess = "true", ClampMin = 0.0f))
+	float ClimbLineOfSightCacheTime = 0.5f;
+
+	/** The actor's own net update frequency, used whenever the climber is not simply climbing */
+	float DefaultNetUpdateFrequency = 0.0f;
+
+	float ClimbIdleTime = 0.0f;
+	bool bIsClimbDormant = false;
+	bool bWasInClimbTransition = false;
+
+	struct FClimbLineOfSight
+	{
+		double CheckTime = 0.0;
+		bool bHasLineOfSight = false;
+	};
+
+	/** Per viewer, relevancy is asked per connection and net update. Expired entries are dropped in UpdateClimbReplication */
+	mutable TMap<TObjectKey<AActor>, FClimbLineOfSight> ClimbLineOfSightCache;
+#pragma endregion
+
+#pragma region Climb Animation
+	/** Far AI climbers in a climb or hang loop take their pose from the animation sharing manager instead of evaluating their own graph */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Animation", meta = (AllowPrivateAccess = "true"))
+	bool bUseAnimationSharing = true;
+
+	/** Creates the animation sharing manager if the world does not have one yet. Uses UClimbAnimationSharingStateProcessor */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Animation", meta = (AllowPrivateAccess = "true"))
+	TSoftObjectPtr<UAnimationSharingSetup> AnimationSharingSetup;
+
+	/** Climbers further than this from every local view share their animation */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Animation", meta = (AllowPrivateAccess = "true", ClampMin = 0.0f))
+	float AnimationSharingDistance = 3000.0f;
+
+	/** Seconds between distance checks. Leaving a shared loop is checked every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Animation", meta = (AllowPrivateAccess = "true", ClampMin = 0.0f))
+	float AnimationSharingCheckInterval = 0.5f;
+
+	float AnimationSharingCheckTimer = 0.0f;
+	bool bIsFarForAnimationSharing = false;
+	bool bIsAnimationShared = false;
+#pragma endregion
+
 public:
 	AClimbForgeCharacter(const FObjectInitializer& ObjectInitializer);
+
+	/** Subobject names, so derived classes can skip creating the camera */
+	static FName CameraBoomName;
+	static FName FollowCameraName;
 	
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
@@ -80,14 +228,47 @@ public:
 
 	FORCEINLINE UClimbForgeMovementComponent* GetClimbForgeMovementComponent() const { return ClimbForgeMovementComponent; }
 	FORCEINLINE UMotionWarpingComponent* GetMotionWarpingComponent() const { return MotionWarpingComponent; }
+	FORCEINLINE bool IsInPool() const { return bIsInPool; }
+
+	FORCEINLINE const FClimbReplicatedState& GetReplicatedClimbState() const { return ReplicatedClimbState; }
+	FORCEINLINE void SetReplicatedClimbState(const FClimbReplicatedState& InState) { ReplicatedClimbState = InState; }
+
+	/** Client to server: a climb action such as getting on the wall or a dash was started locally and needs the server's confirmation */
+	UFUNCTION(Server, Reliable)
+	void ServerRequestClimbAction(const FClimbPredictedActionRequest& Request);
+
+	/** Server to client: the outcome of a ServerRequestClimbAction */
+	UFUNCTION(Client, Reliable)
+	void ClientResolveClimbAction(const FClimbPredictedActionResult& Result);
+
+	/** Park the character in a pool: reset its climb state and stop it from ticking, rendering and colliding */
+	void DeactivateForPool();
+
+	/** Bring a pooled character back at the given transform */
+	void ActivateFromPool(const FTransform& InTransform);
+
+	/** While set, every climb relevant input is handed to the UClimbReplaySubsystem */
+	FORCEINLINE void SetRecordingInput(const bool bInIsRecordingInput) { bIsRecordingInput = bInIsRecordingInput; }
+
+	/** Run a recorded input through the same handler the live input goes to */
+	void ReplayInput(const EClimbRecordedAction Action, const FInputActionValue& Value);
 	
 protected:
 	virtual void NotifyControllerChanged() override;
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	 void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel,
+		float Time, bool bLowBandwidth) override;
 	
 private:
+	UFUNCTION()
+	void OnRep_ReplicatedClimbState();
+
 	/** Called for looking input */
 	void Look(const FInputActionValue& Value);
 
@@ -97,12 +278,49 @@ private:
 
 	void HandleClimbingMovement(const FInputActionValue& Value);
 	void HandleGroundMovement(const FInputActionValue& Value);
+	void HandleJump();
+
+	// Only bound for the recording, the release of a held action is what ends it in the replay.
+	void HeldActionCompleted(const FInputActionInstance& Instance);
+	void RecordInput(const EClimbRecordedAction Action, const FInputActionValue& Value) const;
 
 	void OnEnterClimbingMode();
 	void OnExitClimbingMode();
 
+	bool IsClimbingOrHanging() const;
+
+	/** Authority only: net update frequency and dormancy from what the climber is doing */
+	void UpdateClimbReplication(const float DeltaSeconds);
+
+	bool HasClimbLineOfSight(const AActor* Viewer, const AActor* ViewTarget, const FVector& ViewLocation) const;
+
+	/** Register with the animation sharing manager while far away and in a shareable loop, unregister otherwise */
+	void UpdateAnimationSharing(const float DeltaSeconds);
+	void SetAnimationShared(const bool bShared);
+	bool IsFarFromLocalViews() const;
+
+	void EnterClimbingCamera();
+	void ExitClimbingCamera();
+	void UpdateClimbingCamera(const float DeltaSeconds);
+
+	// The arm length the boom would settle at for the current view, using a single probe sweep.
+	float ProbeClimbingCameraArmLength() const;
+
 	void AddInputMappingContext(const UInputMappingContext* InContext, int32 InPriority);
 	void RemoveInputMappingContext(const UInputMappingContext* InContext);
+
+	// Build ClimbingInputLayer from ClimbingMappingContext, once. The climbing context has the higher priority, so a key one of its
+	// actions consumes would never reach the default context while both are registered. Those actions are mapped through copies
+	// that let the key through, and the handlers of both contexts check bIsClimbingInputActive instead.
+	void BuildClimbingInputLayer();
+
+	// The copy ClimbingInputLayer maps in place of the given climbing action, or the action itself.
+	const UInputAction* GetClimbingLayerAction(const UInputAction* InAction) const;
+
+public:
+	// Time InIterations climbing input toggles with the persistent layer and with mapping context add/remove.
+	// Exposed for the ClimbForge.BenchmarkInputToggle console command.
+	void BenchmarkClimbingInputToggle(const int32 InIterations);
 };
 
 
@@ -4,13 +4,125 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+#include "ClimbHeightfield.h"
+#include "ClimbLimb.h"
+#include "ClimbMath.h"
+#include "ClimbPredictedAction.h"
+#include "ClimbReplicatedState.h"
+#include "ClimbSurfacePoint.h"
+#include "ClimbTelemetry.h"
+#include "WorldCollision.h"
+#include "Components/PrimitiveComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "ClimbForgeMovementComponent.generated.h"
 
-enum class EClimbingDirection : uint8;
+class UClimbQueryBudgetSubsystem;
+
 DECLARE_DELEGATE(FOnEnterClimbingModeDelegate);
 DECLARE_DELEGATE(FOnExitClimbingModeDelegate);
 
+// A straight piece of ledge that is extracted once when the character starts hanging.
+// Shimmying moves along it analytically and the world is probed again only when the character runs off one of its ends.
+struct FClimbLedgeSegment
+{
+	// Both points are on the top edge of the wall face.
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+
+	// Unit vector from Start to End. Stored separately so that a single point ledge still has a direction.
+	FVector Direction = FVector::ZeroVector;
+
+	// Horizontal normal of the wall face, pointing away from the wall.
+	FVector WallNormal = FVector::ZeroVector;
+
+	// The movable component the ledge belongs to and its transform when the segment was last placed, see FollowBase.
+	TWeakObjectPtr<UPrimitiveComponent> Base;
+	FTransform BaseTransform;
+
+	void SetBase(UPrimitiveComponent* InBase)
+	{
+		const bool bIsMovable = InBase != nullptr && InBase->Mobility == EComponentMobility::Movable;
+		Base = bIsMovable ? InBase : nullptr;
+		BaseTransform = bIsMovable ? InBase->GetComponentTransform() : FTransform::Identity;
+	}
+
+	// Carry the segment along with the rigid motion of its base since it was last placed. Returns false if nothing moved.
+	bool FollowBase()
+	{
+		const UPrimitiveComponent* BaseComponent = Base.Get();
+		if (BaseComponent == nullptr) return false;
+
+		const FTransform& CurrentTransform = BaseComponent->GetComponentTransform();
+		if (CurrentTransform.Equals(BaseTransform, UE_KINDA_SMALL_NUMBER)) return false;
+
+		const FTransform Delta = BaseTransform.Inverse() * CurrentTransform;
+		Start = Delta.TransformPosition(Start);
+		End = Delta.TransformPosition(End);
+		Direction = Delta.TransformVectorNoScale(Direction);
+		WallNormal = Delta.TransformVectorNoScale(WallNormal);
+		BaseTransform = CurrentTransform;
+		return true;
+	}
+
+	FORCEINLINE float GetLength() const { return FVector::Dist(Start, End); }
+	FORCEINLINE FVector GetPointAt(const float Distance) const { return Start + Direction * Distance; }
+	FORCEINLINE float GetDistanceOf(const FVector& Point) const { return FVector::DotProduct(Point - Start, Direction); }
+	FORCEINLINE bool IsValid() const { return !WallNormal.IsNearlyZero() && !Direction.IsNearlyZero(); }
+};
+
+// How TraceClimbableSurfaces generates the contacts with the climbable surfaces.
+UENUM()
+enum class EClimbContactGeneration : uint8
+{
+	// Sweep the climb capsule one unit forward. Its contacts start penetrating, so their normals are penetration normals.
+	Sweep,
+	// Overlap the climb capsule and take the closest point of every overlapped primitive, the normals are face normals.
+	// Falls back to the sweep for primitives without simple collision.
+	Overlap
+};
+
+enum class EClimbPrefetchQuery : uint8
+{
+	// The capsule sweep of TraceClimbableSurfaces.
+	Surface,
+	// The eye height trace of HasReachedTheLedge. When it finds the lip it is followed by the ledge top trace and the headroom sweep.
+	Ledge
+};
+
+// The step a ledge prefetch is waiting for.
+enum class EClimbLedgePrefetchStep : uint8
+{
+	EyeTrace,
+	TopTrace,
+	HeadroomSweep
+};
+
+// A climb query issued ahead of time for where the climber is expected to be, see UpdateClimbPrefetches.
+struct FClimbPrefetchedQuery
+{
+	EClimbPrefetchQuery Kind = EClimbPrefetchQuery::Surface;
+	EClimbLedgePrefetchStep LedgeStep = EClimbLedgePrefetchStep::EyeTrace;
+
+	// Component location and forward vector the query was made for.
+	FVector Location = FVector::ZeroVector;
+	FVector Forward = FVector::ZeroVector;
+
+	FTraceHandle Handle;
+	TArray<FHitResult> Hits;
+
+	// Ledge only. With the wall still at eye height the lip is higher up. Otherwise the walkable top, if any, and whether the capsule
+	// is blocked on it.
+	bool bWallAtEyeHeight = false;
+	FHitResult LedgeTopHit;
+	bool bLedgeTopBlocked = false;
+
+	double IssueTime = 0.0;
+	bool bIsReady = false;
+
+	FORCEINLINE bool IsInUse() const { return Handle.IsValid() || bIsReady; }
+};
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class CLIMBFORGE_API UClimbForgeMovementComponent : public UCharacterMovementComponent
 {
@@ -23,25 +135,107 @@ private:
 #pragma region ClimbCoreVariables
 	TArray<FHitResult> ClimbableSurfacesHits;
 
+	// ClimbableSurfacesHits packed for the SIMD contact pass and its result, refreshed whenever the hits are traced.
+	ClimbMath::FClimbContactBatch ClimbContactBatch;
+	ClimbMath::FClimbContactSummary ClimbContactSummary;
+
+	// Scratch batch for the floor sweep in HasReachedTheFloor.
+	ClimbMath::FClimbContactBatch FloorContactBatch;
+
+	// Scratch heights for the edge scan of CanStartVaulting on terrain.
+	TArray<float, TAlignedHeapAllocator<16>> VaultEdgeHeights;
+
 	FCollisionQueryParams ClimbQueryParams;
 
 	FVector ClimbableSurfaceLocation;
 	
 	FVector ClimbableSurfaceNormal;
 
+	// The averaged contact on the component of the best candidate hit, ClimbableSurfaceLocation and Normal are resolved from it.
+	// Async sweeps land a frame late, this keeps their result on a wall that moved in the meantime.
+	FClimbSurfacePoint ClimbableSurface;
+
+	// The component the best candidate hit belongs to, the character is based on it while climbing.
+	TWeakObjectPtr<UPrimitiveComponent> ClimbableSurfaceComponent;
+
+	// Where the last normal refinement fan was cast from and the face normal it found, see RefineClimbableSurfaceNormal.
+	FClimbSurfacePoint RefinedClimbableSurface;
+	TWeakObjectPtr<UPrimitiveComponent> RefinedClimbableSurfaceComponent;
+
 	float OwnerColliderCapsuleHalfHeight;
 
 	UPROPERTY()
 	TObjectPtr<UAnimInstance> OwnerActorAnimInstance;
 
+	UPROPERTY()
+	TObjectPtr<UClimbQueryBudgetSubsystem> ClimbQueryBudget;
+
+	// A climb request that was turned away by the query budget, it is tried again once the budget admits this climber.
+	bool bClimbRequestDeferred = false;
+
 	FVector CharacterLocationBeforeDashMontage;
 
+	// Direction of the climb dash montage that is playing, Idle when none is.
+	EClimbingDirection ActiveClimbDashDirection = EClimbingDirection::Idle;
+
+	// The action this client is playing ahead of the server's confirmation. Only one montage plays at a time so one is enough.
+	FClimbPredictedActionRequest PendingPredictedAction;
+	uint8 NextPredictedActionId = 0;
+
 	bool bMoveToTargetAfterClimb = false;
-	FVector ClimbToLedgeTargetLocation;
+
+	// Kept on the ledge's component so walking to it after the climb still works on a moving platform.
+	FClimbSurfacePoint ClimbToLedgeTarget;
+
+	// Latest climbable surface received from the authority. Simulated proxies ease ClimbableSurfaceLocation and Normal towards it.
+	FClimbSurfacePoint ReplicatedClimbableSurface;
 	float LedgeSurfaceSlopeDegrees;
 	bool bUsedMotionWarpForLedgeClimb = false;
 	
 #pragma endregion
+
+#pragma region ClimbStepVariables
+	// Time not yet simulated by the fixed climb step.
+	float ClimbStepAccumulator = 0.0f;
+
+	// Capsule transform before the last fixed climb step, the mesh is interpolated from it towards the current one.
+	FTransform PreviousClimbStepTransform;
+
+	// Climb steps simulated during the current tick. The wall is only traced again after it moved.
+	int32 NumClimbStepsThisFrame = 0;
+
+	// Climb sweep in flight on the async trace tasks, its hits are picked up on the next trace.
+	FTraceHandle PendingClimbSweepHandle;
+#pragma endregion
+
+#pragma region ClimbPrefetchVariables
+	FClimbPrefetchedQuery ClimbPrefetches[8];
+#pragma endregion
+
+#pragma region ClimbIKVariables
+	FClimbLimbTarget LimbTargets[static_cast<uint8>(EClimbLimb::MAX)];
+
+	// The cached hold of each limb on its component, LimbTargets is resolved from it every update.
+	FClimbSurfacePoint LimbHolds[static_cast<uint8>(EClimbLimb::MAX)];
+
+	// Limb probes in flight on the async trace tasks. Issued together with the climb sweep and picked up on the next one.
+	FTraceHandle LimbProbeHandles[static_cast<uint8>(EClimbLimb::MAX)];
+
+	// Probes in a row that found no hold for each limb, and the world time before which the limb is not probed again.
+	uint8 LimbProbeMisses[static_cast<uint8>(EClimbLimb::MAX)] = {};
+	double LimbProbeRetryTime[static_cast<uint8>(EClimbLimb::MAX)] = {};
+#pragma endregion
+
+#pragma region HangCoreVariables
+	FClimbLedgeSegment LedgeSegment;
+
+	// Distance of the hang point from LedgeSegment.Start.
+	float LedgeSegmentDistance = 0.0f;
+
+	// The end (-1 start, 1 end) of the segment that was probed and found to have no ledge beyond it.
+	// Prevents re-probing every tick while the player keeps pushing against the end of the ledge.
+	int8 BlockedLedgeSegmentEnd = 0;
+#pragma endregion
 	
 #pragma region ClimbBPVariables
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true))
@@ -68,6 +262,27 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true))
 	float MinimumClimbableAngleInDegrees = 25.0f;
 
+	// With more than one contact, take the climb normal from a fan of line traces against the wall instead of averaging the
+	// penetration normals of the contacts, which wobble at seams and corners.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true))
+	bool bRefineClimbNormals = true;
+
+	// Angle of the outer traces of the fan from the averaged normal, to the left, right, up and down.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true, ClampMin=0.0f, ClampMax=60.0f, EditCondition="bRefineClimbNormals"))
+	float ClimbNormalFanAngle = 25.0f;
+
+	// Contacts whose normals are all within this angle of their average agree on the wall, the fan is not cast for them.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true, ClampMin=0.0f, ClampMax=90.0f, EditCondition="bRefineClimbNormals"))
+	float ClimbNormalAgreementAngle = 5.0f;
+
+	// Outer fan hits further than this from the normal of the center hit are on some other surface and are left out.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true, ClampMin=0.0f, ClampMax=90.0f, EditCondition="bRefineClimbNormals"))
+	float ClimbNormalMaxFanDeviation = 45.0f;
+
+	// The refined normal is reused until the climber moved this far from where the fan was cast.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true, ClampMin=0.0f, EditCondition="bRefineClimbNormals"))
+	float ClimbNormalRefinementDistance = 5.0f;
+
 	UPROPERTY(EditDefaultsOnly,BlueprintReadOnly,Category = "Character Movement: Climb",meta = (AllowPrivateAccess = "true"))
 	float ClimbDownWalkableSurfaceTraceOffset = 100.f;
 
@@ -104,6 +319,116 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb", meta=(AllowPrivateAccess=true))
 	TObjectPtr<UAnimMontage> ClimbDashRightMontage;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	bool bGenerateLimbTargets = true;
+
+	// Height of the hands above the capsule center while climbing.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	float HandTargetHeight = 60.0f;
+
+	// Distance of each hand from the capsule center along the character's right vector.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	float HandTargetSpread = 25.0f;
+
+	// Height of the feet above the capsule center while climbing (negative is below).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	float FootTargetHeight = -70.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	float FootTargetSpread = 15.0f;
+
+	// A planted limb keeps its cached hold until the body has moved this far from it along the wall.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	float LimbStrideThreshold = 30.0f;
+
+	// How far past the climbable surface a limb probe reaches to find a hold.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true))
+	float LimbProbeDepth = 30.0f;
+
+	// A limb whose probe found no hold is probed again after this long, times its misses in a row up to four.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb IK", meta=(AllowPrivateAccess=true, ClampMin=0.0f))
+	float LimbMissRetryInterval = 0.1f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float MaxHangShimmySpeed = 60.0f;
+
+	// Distance of the capsule center below the top of the ledge while hanging.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangHeightBelowLedge = 95.0f;
+
+	// Distance of the capsule center from the wall face while hanging.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangWallOffset = 35.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangEntryTraceDistance = 100.0f;
+
+	// How far from the expected height the ledge top can be when grabbing it from the air.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangLedgeGrabTolerance = 40.0f;
+
+	// How much the ledge top can change in height before the ledge is considered to have ended.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangLedgeHeightTolerance = 10.0f;
+
+	// How far into the wall top the ledge height is sampled.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangLedgeInset = 10.0f;
+
+	// Spacing of the samples taken along the ledge when a segment is extracted.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float HangLedgeProbeStep = 25.0f;
+
+	// How far to each side of the grab point a single segment extends at most.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Hang", meta=(AllowPrivateAccess=true))
+	float MaxLedgeSegmentHalfLength = 200.0f;
+
+	// Simulate climbing at ClimbSimulationRate instead of once per frame, interpolating the mesh between the steps.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true))
+	bool bUseFixedClimbStep = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true, ClampMin=10.0f, EditCondition="bUseFixedClimbStep"))
+	float ClimbSimulationRate = 60.0f;
+
+	// Steps beyond this in a single frame are dropped, so a hitch does not make the next frame even slower.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true, ClampMin=1, EditCondition="bUseFixedClimbStep"))
+	int32 MaxClimbStepsPerFrame = 4;
+
+	// While climbing, run the wall sweep as an async trace that overlaps with the rest of the frame.
+	// The climb step then works on the hits of the previous frame's sweep.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true))
+	bool bUseAsyncClimbTraces = false;
+
+	// Contact generation of the synchronous climb capsule query. The async and prefetched queries always sweep.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true))
+	EClimbContactGeneration ClimbContactGeneration = EClimbContactGeneration::Sweep;
+
+	// Issue async surface and ledge queries for where the climber will be ClimbPrefetchLookaheadTime from now, so that reaching a corner
+	// does not need a synchronous sweep on that frame. Ledge results only count when made at or above the climber, so they cannot hide
+	// the lip, and reaching the lip is confirmed with a single eye height trace.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true))
+	bool bPrefetchClimbQueries = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true, ClampMin=0.0f, EditCondition="bPrefetchClimbQueries"))
+	float ClimbPrefetchLookaheadTime = 0.15f;
+
+	// How close the climber has to be to where a prefetched query was made for its result to be used.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true, ClampMin=0.0f, EditCondition="bPrefetchClimbQueries"))
+	float ClimbPrefetchTolerance = 8.0f;
+
+	// Answer the floor, ledge, climb down and vault landing probes against a landscape from its heightfield instead of tracing.
+	// These probes then do not see meshes placed on the terrain, only turn it on for levels whose terrain is bare landscape.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Simulation", meta=(AllowPrivateAccess=true))
+	bool bUseHeightfieldQueries = false;
+
+	// How far the server's warp target may be from the client's before the server corrects a predicted action.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Networking", meta=(AllowPrivateAccess=true))
+	float PredictedActionWarpTolerance = 25.0f;
+
+	// How fast simulated proxies ease the climbable surface towards the replicated one. Zero snaps to it.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category= "Character Movement: Climb Networking", meta=(AllowPrivateAccess=true, ClampMin=0.0f))
+	float SimulatedClimbSmoothingSpeed = 12.0f;
+
 	UPROPERTY(EditDefaultsOnly,BlueprintReadOnly,Category = "Character Movement: Vault", meta = (AllowPrivateAccess = "true"))
 	float MinimumVaultTraceDistance = 50.f;
 
@@ -119,9 +444,34 @@ public:
 #pragma region ClimbCore
 	void ToggleClimbing(const bool bEnableClimb);
 	void RequestClimbDash();
+	void TryStartVaulting();
+
+	// Put the component back into the state it is in right after BeginPlay, without re-running it.
+	// Used when a pooled climber is released so it can be reused without being respawned.
+	void ResetClimbState();
+
+	// Quantized copy of the climb state for simulated proxies, built by the authority.
+	FClimbReplicatedState BuildReplicatedClimbState() const;
+
+	// Take over the climb state received from the authority. Only used on simulated proxies.
+	void ApplyReplicatedClimbState(const FClimbReplicatedState& InState);
+
+	// Server side: validate a predicted action against the server's own queries and tell the client the outcome.
+	void HandlePredictedActionRequest(const FClimbPredictedActionRequest& Request);
+
+	// Client side: the server confirmed, corrected or rejected the pending predicted action.
+	void HandlePredictedActionResult(const FClimbPredictedActionResult& Result);
 	
 	bool IsClimbing() const;
+	bool IsHanging() const;
+
+	// A climb dash, ledge climb, vault or predicted action is in progress.
+	bool IsInClimbTransition() const;
+	FORCEINLINE float GetMaxClimbSpeed() const {return MaxClimbSpeed;}
 	FORCEINLINE FVector GetClimbableSurfaceNormal() const {return ClimbableSurfaceNormal;}
+	FORCEINLINE FVector GetClimbableSurfaceLocation() const {return ClimbableSurfaceLocation;}
+	FORCEINLINE FVector GetClimbToLedgeTargetLocation() const {return ClimbToLedgeTarget.GetLocation();}
+	FORCEINLINE const FClimbLimbTarget& GetLimbTarget(const EClimbLimb Limb) const {return LimbTargets[static_cast<uint8>(Limb)];}
 
 	// When the actor is climbing the velocity is rotated along with the actor's rotation (see - GetClimbRotation).
 	// In order to get the correct component velocity we need to unrotate it.
@@ -143,49 +493,158 @@ protected:
 private:
 #pragma region ClimbTraces
 	// Use the Capsule shape with SweepMultiByChannel to check for any climbable surfaces from the ClimbableSurfaceTraceChannel 
-	TArray<FHitResult> CapsuleSweepTraceByChannel(const FVector& Start, const FVector& End, const bool bShowDebugShape = false, const bool bShowPersistent = 
-	false);
+	TArray<FHitResult> CapsuleSweepTraceByChannel(const FVector& Start, const FVector& End);
+
+	// Contacts of the climb capsule at the given location from an overlap and the closest point of every overlapped primitive.
+	// Sweeps instead if one of the primitives cannot be queried for its closest point, see EClimbContactGeneration.
+	TArray<FHitResult> CapsuleOverlapByChannel(const FVector& Location);
 
 	// Use the LineTraceSingleByChannel to check for any climbable surface from the ClimbableSurfaceTraceChannel which is
 	// at the given start and end, usually the eye height, as character can be in front of a ledge which would come as a
 	// hit from the capsule sweep but is not a legit climbable surface.
-	FHitResult LineTraceByChannel(const FVector& Start, const FVector& End, const bool bShowDebugShape = false, const bool bShowPersistent = false);
+	FHitResult LineTraceByChannel(const FVector& Start, const FVector& End);
+
+	// LineTraceByChannel for probes that look for the ground below Start. Answered from the heightfield when Ground is a landscape.
+	FHitResult GroundTraceByChannel(const FVector& Start, const FVector& End, UPrimitiveComponent* Ground);
+
+	// The heightfield of the component if it is a landscape and bUseHeightfieldQueries is set, an empty one otherwise.
+	FClimbHeightfield GetClimbHeightfield(UPrimitiveComponent* Component) const;
 #pragma endregion
 
 #pragma region ClimbCore
 	// Trace for all climbable surfaces.
 	bool TraceClimbableSurfaces();
 
+	// Whether the world's climb query budget lets this climber run its optional queries this frame.
+	bool CanRunClimbQueries() const;
+
+	// Collect the prefetched queries that finished, drop the stale ones and queue new ones along the extrapolated path.
+	void UpdateClimbPrefetches();
+
+	void IssueClimbPrefetch(const EClimbPrefetchQuery Kind, const FVector& Location, const FVector& Forward, const FVector& Up);
+
+	// Take the finished step of a ledge prefetch and issue the next one.
+	void AdvanceLedgePrefetch(FClimbPrefetchedQuery& Query, const FTraceDatum& Result);
+
+	// A finished surface prefetch made close enough to the given location and facing. Null if there is none.
+	const FClimbPrefetchedQuery* FindClimbPrefetch(const FVector& Location, const FVector& Forward) const;
+
+	// The closest finished ledge prefetch made at or up to a capsule half height above the climber, within the prefetch tolerance
+	// sideways. Null if there is none.
+	const FClimbPrefetchedQuery* FindLedgePrefetch() const;
+
+	void ClearClimbPrefetches();
+
+	// Run the fused contact pass over ClimbableSurfacesHits.
+	void UpdateClimbContactSummary();
+
+	// Take the hits of the finished async sweep, if any, and queue the next one from the given start and end.
+	void ExchangeAsyncClimbSweep(const FVector& Start, const FVector& End);
+
 	// Trace from the eye height and see if the ray collides with an object.
 	// This helps us decide whether the character can climb.
-	FHitResult TraceFromEyeHeight(const float TraceDistance, const float TraceStartOffset = 0.0f, const bool bShowDebugShape = false, const bool 
-	bShowPersistent = false);
+	FHitResult TraceFromEyeHeight(const float TraceDistance, const float TraceStartOffset = 0.0f);
 
 	bool CanStartClimbing();
 	bool CanStartClimbingDown();	
 	bool ShouldStopClimbing();
 	bool HasReachedTheFloor();
 	bool HasReachedTheLedge();
-	void TryStartVaulting();
-	bool CanStartVaulting(FVector& VaultStartPosition, FVector& VaultLandPosition);	
+	// Take the walkable top found above the lip as the ledge climb target.
+	void TakeLedgeTarget(const FHitResult& WalkableSurfaceHit);
+	// A ledge target is only meaningful while the climb up montage plays or the climber walks to the target after it.
+	bool IsLedgeClimbInProgress() const;
+	// Drops the ledge target and its warp target once a ledge climb is cancelled or ends away from the target.
+	void ClearLedgeClimb();
+	bool CanStartVaulting(FVector& VaultStartPosition, FVector& VaultLandPosition, EClimbVaultFailReason& OutFailReason);
 	void StartClimbing();
-	void StopClimbing();
+	void StopClimbing(const EClimbStopReason Reason);
+
+	bool CanStartHanging(FClimbLedgeSegment& OutSegment, float& OutSegmentDistance);
+	void TryStartHanging();
+	// Grab the ledge in reach. Shared by the predicting client and the server, which runs the ledge queries again.
+	bool StartHanging();
+
+	// Find the ledge top just behind the given point on the wall face.
+	bool FindLedgeTop(const FVector& WallFacePoint, const FVector& WallNormal, const float ExpectedTopZ, const float Tolerance, FHitResult& OutTopHit);
+
+	// Walk along the ledge from the given wall point and build the longest straight segment around it.
+	bool ExtractLedgeSegment(const FVector& WallFacePoint, const FVector& WallNormal, const float ExpectedTopZ, const float Tolerance,
+		FClimbLedgeSegment& OutSegment);
+
+	// Try to continue the ledge past the given end of the current segment. Returns false if the ledge ends there.
+	bool ExtendLedgeSegment(const int8 SegmentEnd);
+
+	void PhysHanging(float DeltaTime, int32 Iterations);
+
+	FVector GetHangLocation(const float SegmentDistance) const;
 
 	bool CanStartClimbDash(const EClimbingDirection ClimbingDirection, FVector& OutDashHitPoint);
 	void TryPerformClimbDash(const EClimbingDirection ClimbingDirection);
 	
 	void PhysClimbing(float DeltaTime, int32 Iterations);
 
+	// A single climb step: stop checks, velocity, move and snap.
+	void SimulateClimbStep(const float DeltaTime);
+
+	// Place the mesh between the last two fixed climb steps. Alpha is the fraction of a step not simulated yet.
+	void UpdateClimbStepInterpolation(const float Alpha) const;
+
+	// Drop any pending step time and put the mesh back on the capsule.
+	void ResetClimbStepInterpolation();
+
 	// Get the average location from all the climbable hit results.
 	void ProcessClimbableSurfaces();
 
+	// Face normal of the wall in front of the climber from a fixed fan of line traces. The outer traces only count if they are within
+	// ClimbNormalMaxFanDeviation of the center one. The averaged normal if the contacts agree or the center trace finds no wall.
+	FVector RefineClimbableSurfaceNormal(const FVector& AveragedNormal);
+
+	// Where the given limb wants to be with the character at its current location and rotation.
+	FVector GetLimbAnchor(const EClimbLimb Limb) const;
+
+	// Take the limb probes that finished since the last update, then issue async probes together for the limbs that strayed past
+	// LimbStrideThreshold or have no hold. Planted limbs keep their cached hold, limbs that keep missing are probed less often.
+	void UpdateLimbTargets();
+
+	// Plant the limb on the probe's hit, or unplant it if there is none.
+	void ApplyLimbProbe(const EClimbLimb Limb, const FHitResult* LimbHit);
+
+	// Place every limb on the plane of the climbable surface without probing. Used where the climb is not simulated.
+	void ProjectLimbTargetsOntoSurface();
+
+	// Simulated proxies do not query the world, they ease the surface and limbs towards the replicated climb state instead.
+	void SmoothReplicatedClimbState(const float DeltaTime);
+
+	void ClearLimbTargets();
+
+	// Snapshot of the climb state for the Visual Logger, which records into Insights and shows in the Rewind Debugger.
+	void RecordClimbStateToVisualLog() const;
+
 	// Get the rotation required to rotate the actor to face the climbable surface.
 	FQuat GetClimbRotation(float DeltaTime) const;
 
 	// Snap the actor (movement) to the climbable surface and lock onto it.
 	void SnapToClimbableSurface(float DeltaTime) const;
 
-	void PlayMontage(const TObjectPtr<UAnimMontage>& MontageToPlay) const;
+	// Returns false if the montage could not be started, for example because another one is playing.
+	bool PlayMontage(const TObjectPtr<UAnimMontage>& MontageToPlay) const;
+
+	UAnimMontage* GetClimbDashMontage(const EClimbingDirection ClimbingDirection) const;
+
+	// Start the montage of a predicted action with the given warp targets. Shared by the predicting client and the server.
+	bool StartPredictedAction(const EClimbPredictedAction Action, const EClimbingDirection Direction, const FVector& WarpTarget,
+		const FVector& SecondaryWarpTarget);
+
+	void SetPredictedActionWarpTargets(const EClimbPredictedAction Action, const FVector& WarpTarget, const FVector& SecondaryWarpTarget);
+
+	// Tell the server about an action this client just started. Does nothing where the movement is not predicted.
+	void SendPredictedAction(const EClimbPredictedAction Action, const EClimbingDirection Direction, const FVector& WarpTarget,
+		const FVector& SecondaryWarpTarget);
+
+	// Climb actions are started where the pawn is controlled. The server waits for the request of a remote client instead of
+	// starting the same action a second time from its own simulation.
+	bool CanInitiateClimbActions() const;
 
 	UFUNCTION()
 	void MontageEnded(UAnimMontage* Montage, bool bInterrupted);
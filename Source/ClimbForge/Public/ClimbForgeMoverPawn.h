@@ -0,0 +1,113 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbMoverInputs.h"
+#include "MoverSimulationTypes.h"
+#include "GameFramework/Pawn.h"
+#include "ClimbForgeMoverPawn.generated.h"
+
+class UCapsuleComponent;
+class USkeletalMeshComponent;
+class USpringArmComponent;
+class UCameraComponent;
+class UClimbMoverComponent;
+class UInputMappingContext;
+class UInputAction;
+struct FInputActionValue;
+
+/**
+ * Climber that moves with a UClimbMoverComponent instead of a UClimbForgeMovementComponent. Its input, including the climb, dash and
+ * vault requests, only reaches the movement through the input commands it produces, see FClimbMoverInputs.
+ */
+UCLASS(config=Game)
+class CLIMBFORGE_API AClimbForgeMoverPawn : public APawn, public IMoverInputProducerInterface
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Climber, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UCapsuleComponent> CapsuleComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Climber, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<USkeletalMeshComponent> Mesh;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Climber, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UClimbMoverComponent> MoverComponent;
+
+	/** Camera boom positioning the camera behind the climber */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<USpringArmComponent> CameraBoom;
+
+	/** Follow camera */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UCameraComponent> FollowCamera;
+
+#pragma region Input
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputMappingContext> DefaultMappingContext;
+
+	/** Maps the climbing actions, registered for the whole session next to the default one. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputMappingContext> ClimbingMappingContext;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputAction> MoveAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputAction> LookAction;
+
+	/** Climb or vault what is in front, or let go of the wall. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputAction> ClimbAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputAction> ClimbMoveAction;
+
+	/** Climb dash in the direction of the stick. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UInputAction> ClimbHopAction;
+#pragma endregion
+
+	// Last value of the move stick, X right and Y forward or up.
+	FVector2D MoveStick = FVector2D::ZeroVector;
+
+	// Requests made since the last input command. They go into the next one only.
+	FClimbMoverInputs PendingClimbInputs;
+
+public:
+	AClimbForgeMoverPawn(const FObjectInitializer& ObjectInitializer);
+
+	// Climb the wall or vault the obstacle in front of the walking climber.
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Mover")
+	void RequestClimb();
+
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Mover")
+	void RequestVault();
+
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Mover")
+	void RequestLetGo();
+
+	// Dash along the wall if there is wall to hold on to where the dash ends.
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Mover")
+	void RequestClimbDash(const EClimbingDirection Direction);
+
+	FORCEINLINE UClimbMoverComponent* GetClimbMoverComponent() const { return MoverComponent; }
+
+protected:
+	virtual void NotifyControllerChanged() override;
+	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
+
+	virtual void ProduceInput_Implementation(int32 SimTimeMs, FMoverInputCmdContext& InputCmdResult) override;
+
+private:
+	void Move(const FInputActionValue& Value);
+	void MoveCompleted(const FInputActionValue& Value);
+	void Look(const FInputActionValue& Value);
+	void ClimbStarted(const FInputActionValue& Value);
+	void ClimbHopStarted(const FInputActionValue& Value);
+
+	void AddInputMappingContext(const UInputMappingContext* InContext, int32 InPriority);
+};
@@ -0,0 +1,10 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+// Everything ClimbForge measures shows up under "stat ClimbForge".
+DECLARE_STATS_GROUP(TEXT("ClimbForge"), STATGROUP_ClimbForge, STATCAT_Advanced);
@@ -0,0 +1,47 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+
+class ALandscapeProxy;
+class UPrimitiveComponent;
+
+/**
+ * Answers the downward ground probes of the climbing movement by sampling a landscape's heightfield directly instead of
+ * tracing the scene. It only knows the terrain, anything placed on top of the landscape is not seen by it.
+ */
+struct CLIMBFORGE_API FClimbHeightfield
+{
+	FClimbHeightfield() = default;
+
+	// Empty unless the component is landscape collision.
+	explicit FClimbHeightfield(UPrimitiveComponent* InComponent);
+
+	bool IsValid() const { return Landscape != nullptr; }
+
+	// Only lines pointing straight down can be answered from the heightfield.
+	static bool CanTrace(const FVector& Start, const FVector& End);
+
+	// Height of the terrain below the location, unset outside of the landscape.
+	TOptional<float> GetHeight(const FVector& Location) const;
+
+	// Terrain normal from the heights one landscape quad around the location. World up where there are no heights.
+	FVector GetNormal(const FVector& Location) const;
+
+	// What a line trace from Start down to End would return for the terrain, see CanTrace.
+	FHitResult Trace(const FVector& Start, const FVector& End) const;
+
+	// Terrain heights at NumSamples evenly spaced points from Start to End, with -UE_BIG_NUMBER where there is no terrain.
+	// Padded to a multiple of 4 with UE_BIG_NUMBER for ClimbMath::FindFirstHeightBelow. Reuses the allocation of OutHeights.
+	void SampleHeights(const FVector& Start, const FVector& End, const int32 NumSamples, TArray<float, TAlignedHeapAllocator<16>>& OutHeights) const;
+
+private:
+	const ALandscapeProxy* Landscape = nullptr;
+	UPrimitiveComponent* Component = nullptr;
+
+	// Size of a landscape quad.
+	float SampleSpacing = 100.0f;
+};
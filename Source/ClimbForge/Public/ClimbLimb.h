@@ -0,0 +1,35 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbLimb.generated.h"
+
+UENUM(BlueprintType)
+enum class EClimbLimb : uint8
+{
+	LeftHand UMETA(DisplayName="Left Hand"),
+	RightHand UMETA(DisplayName="Right Hand"),
+	LeftFoot UMETA(DisplayName="Left Foot"),
+	RightFoot UMETA(DisplayName="Right Foot"),
+	MAX UMETA(Hidden)
+};
+
+// Where a limb should be placed on the climbable surface. Consumed by the CR_ClimbingIK control rig through the anim instance.
+USTRUCT(BlueprintType)
+struct FClimbLimbTarget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK")
+	FVector Normal = FVector::ZeroVector;
+
+	// False when the last probe for this limb found nothing to hold on to. The rig should blend the limb out.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climbing IK")
+	bool bIsValid = false;
+};
@@ -0,0 +1,25 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MoverComponent.h"
+#include "ClimbMoverComponent.generated.h"
+
+/**
+ * Mover component with the modes of the Mover climbing backend: a UClimbWalkingMode as walking, the default falling and flying
+ * modes, and a UClimbingMode as ClimbModeNames::Climbing. Climbs, dashes and vaults are requested through the FClimbMoverInputs
+ * of the input commands, see AClimbForgeMoverPawn.
+ */
+UCLASS(ClassGroup= "ClimbForge", meta=(BlueprintSpawnableComponent))
+class CLIMBFORGE_API UClimbMoverComponent : public UMoverComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbMoverComponent(const FObjectInitializer& ObjectInitializer);
+
+	UFUNCTION(BlueprintPure, Category= "ClimbForge|Mover")
+	bool IsClimbing() const;
+};
@@ -0,0 +1,51 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+#include "MoverDataModelTypes.h"
+#include "ClimbMoverInputs.generated.h"
+
+/**
+ * Climb intent of one input command, next to the FCharacterDefaultInputs of the command. The modes act on it in their simulation
+ * tick, so it is predicted, sent to the server and replayed on a rollback like the rest of the input: UClimbWalkingMode starts
+ * climbing or vaulting, UClimbingMode lets go or dashes. Each request is only set in the command it is made in.
+ */
+USTRUCT(BlueprintType)
+struct CLIMBFORGE_API FClimbMoverInputs : public FMoverDataStructBase
+{
+	GENERATED_BODY()
+
+	// Start climbing the surface in front of the walking pawn.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	bool bWantsToClimb = false;
+
+	// Vault over the obstacle in front of the walking pawn. Climbing wins if both are requested and there is a wall to climb.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	bool bWantsToVault = false;
+
+	// Let go of the wall.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	bool bWantsToLetGo = false;
+
+	// Dash along the wall, Idle for none.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	EClimbingDirection DashDirection = EClimbingDirection::Idle;
+
+	virtual FMoverDataStructBase* Clone() const override;
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+	virtual void ToString(FAnsiStringBuilderBase& Out) const override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbMoverInputs> : public TStructOpsTypeTraitsBase2<FClimbMoverInputs>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
@@ -0,0 +1,78 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+#include "ClimbMath.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ClimbMoverLibrary.generated.h"
+
+class UClimbMoverSettings;
+struct FLayeredMove_ClimbTraversal;
+
+// Buffers of the climb sweeps, kept by the caller so that a climber that sweeps every step does not allocate every step.
+struct FClimbMoverScratch
+{
+	TArray<FHitResult> Hits;
+	ClimbMath::FClimbContactBatch Contacts;
+};
+
+// The climbable surface in front of a climber, see UClimbMoverLibrary::FindClimbableSurface.
+struct FClimbMoverSurface
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+	UPrimitiveComponent* Component = nullptr;
+
+	// Of the contact that faces the climber the most, see ClimbMath::FClimbContactSummary.
+	float AngleInDegrees = 0.0f;
+	float Steepness = 0.0f;
+};
+
+/**
+ * Climbing for pawns that move with a UMoverComponent instead of a UClimbForgeMovementComponent. These are the queries the
+ * climbing and walking modes run when an FClimbMoverInputs asks them to climb, dash or vault, see UClimbMoverComponent.
+ * They only read the world, the modes turn their results into mode changes and traversals inside the simulation.
+ */
+UCLASS()
+class CLIMBFORGE_API UClimbMoverLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Whether the pawn on the ground at the location faces a climbable surface.
+	static bool CanStartClimbing(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+		const FQuat& Orientation, FClimbMoverScratch& Scratch);
+
+	// Where a climb dash in the direction ends, if there is wall to hold on to there.
+	static bool FindClimbDash(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+		const FQuat& Orientation, const EClimbingDirection Direction, FVector& OutTarget);
+
+	// Control point and landing of a vault over the obstacle in front of the walking pawn. SpeedRatio is the pawn's speed relative
+	// to its max walk speed, faster pawns look for obstacles further ahead.
+	static bool FindVault(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+		const FQuat& Orientation, const float SpeedRatio, FVector& OutControl, FVector& OutTarget);
+
+	// Averaged contacts of the climb capsule at the location, with the climber facing along the orientation.
+	// Returns false if nothing it touches can be climbed. Scratch is reused between calls.
+	static bool FindClimbableSurface(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+		const FQuat& Orientation, FClimbMoverScratch& Scratch, FClimbMoverSurface& OutSurface);
+
+	// Whether the climb capsule a little below the location stands on a floor.
+	static bool IsOnFloor(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+		const FQuat& Orientation, FClimbMoverScratch& Scratch);
+
+	// Where the capsule stands on top of the ledge in front of it, if it can climb up there.
+	static bool FindLedgeTop(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Location,
+		const FQuat& Orientation, const float WalkableFloorZ, FVector& OutStandLocation);
+
+	static FHitResult LineTrace(const UPrimitiveComponent& UpdatedPrimitive, const UClimbMoverSettings& Settings, const FVector& Start,
+		const FVector& End);
+
+	// A FLayeredMove_ClimbTraversal of the given duration in seconds. Movement modes add it to the sync state they output,
+	// see UClimbingMode::OnSimulationTick.
+	static TSharedPtr<FLayeredMove_ClimbTraversal> MakeTraversal(const FVector& Start, const FVector& Control, const FVector& Target,
+		const float Duration, const FName ModeAfterTraversal);
+};
@@ -0,0 +1,75 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MovementMode.h"
+#include "ClimbMoverSettings.generated.h"
+
+/**
+ * Tunables of the Mover climbing backend, shared by the climbing mode and the climb traversals.
+ * They mirror the ones of UClimbForgeMovementComponent. The traversal durations replace the lengths of the montages the
+ * movement component plays.
+ */
+UCLASS(BlueprintType)
+class CLIMBFORGE_API UClimbMoverSettings : public UObject, public IMovementSettingsInterface
+{
+	GENERATED_BODY()
+
+public:
+	virtual FString GetDisplayName() const override { return GetName(); }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float ClimbCollisionCapsuleRadius = 50.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float ClimbCollisionCapsuleHalfHeight = 72.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	TEnumAsByte<ECollisionChannel> ClimbableSurfaceTraceChannel = ECC_Visibility;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float MaxBrakeClimbDeceleration = 400.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float MaxClimbSpeed = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float MaxClimbAcceleration = 300.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float MinimumClimbableAngleInDegrees = 25.0f;
+
+	// Height of the eye traces above the capsule center, the movement component uses the character's BaseEyeHeight.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float ClimbEyeHeight = 64.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float ClimbDashTraceLength = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float ClimbDashEyeHeightTraceOffset = -20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb")
+	float ClimbDashEdgeTraceOffset = 150.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Vault")
+	float MinimumVaultTraceDistance = 50.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Vault")
+	float MaximumVaultTraceDistance = 200.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Traversal", meta=(ClampMin=0.05f))
+	float LedgeClimbDuration = 0.9f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Traversal", meta=(ClampMin=0.05f))
+	float ClimbDashDuration = 0.4f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Traversal", meta=(ClampMin=0.05f))
+	float VaultDuration = 0.7f;
+
+	// How far the ledge climb and vault paths clear the top of the ledge or obstacle.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Traversal")
+	float TraversalClearance = 20.0f;
+};
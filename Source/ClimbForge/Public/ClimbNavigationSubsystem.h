@@ -0,0 +1,215 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbNavigationSubsystem.generated.h"
+
+class UNavLinkCustomComponent;
+
+UENUM(BlueprintType)
+enum class EClimbNavNodeType : uint8
+{
+	// Walkable ground at the foot of a wall or behind a vault.
+	Ground,
+	// Where the capsule is while climbing, one per cell of the wall.
+	Wall,
+	// Walkable ground on top of a wall.
+	LedgeTop
+};
+
+UENUM(BlueprintType)
+enum class EClimbNavLinkType : uint8
+{
+	// Start of a path, nothing was traversed to get there.
+	None,
+	// Climb to the neighboring cell of the same wall.
+	Climb,
+	// Climb dash over a gap in the wall.
+	Dash,
+	// Start climbing from the ground.
+	Mount,
+	// Let go of the wall onto the ground below.
+	Dismount,
+	// Climb over the ledge onto the top of the wall.
+	ClimbUp,
+	// Climb down from the ledge top onto the wall.
+	DropDown,
+	// Vault over a low wall from the ground in front of it to the ground behind it.
+	Vault
+};
+
+USTRUCT(BlueprintType)
+struct FClimbNavBuildSettings
+{
+	GENERATED_BODY()
+
+	// Spacing of the wall samples. Also the largest step between two neighboring wall nodes.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation", meta=(ClampMin=10.0f))
+	float CellSize = 50.0f;
+
+	// Size of the clusters the high level search runs on.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation", meta=(ClampMin=100.0f))
+	float ClusterSize = 800.0f;
+
+	// Should match the climbable surface trace channel of the climbers' movement component.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	// Distance of the capsule center from the wall while climbing.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation")
+	float WallOffset = 45.0f;
+
+	// A dash can cross a gap of up to this many missing cells.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation", meta=(ClampMin=0))
+	int32 MaxDashGapCells = 2;
+
+	// Walls that are at most this high above the ground in front of them are vaulted instead of climbed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation")
+	float MaxVaultHeight = 120.0f;
+
+	// Cost per unit length of climbing relative to walking.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation", meta=(ClampMin=1.0f))
+	float ClimbCostMultiplier = 2.0f;
+
+	// Extra cost of a dash, vault, climb up or drop down on top of its length.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation", meta=(ClampMin=0.0f))
+	float ActionCost = 100.0f;
+
+	// Paths kept in the cache before the oldest ones are dropped.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation", meta=(ClampMin=1))
+	int32 MaxCachedPaths = 512;
+
+	// Also add the routes over walls and the vaults as smart links to the navmesh, so that the MoveTo of an AClimbForgeAICharacter
+	// routes over walls and climbs them. Other agents reaching a link abort their move, give them UNavFilter_NoClimb as filter.
+	// Links added at runtime need a navmesh with RuntimeGeneration DynamicModifiersOnly or Dynamic in the level.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Climb Navigation")
+	bool bAddNavLinks = false;
+};
+
+USTRUCT(BlueprintType)
+struct FClimbNavPathPoint
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climb Navigation")
+	FVector Location = FVector::ZeroVector;
+
+	// Normal of the wall for wall points, world up for the others.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climb Navigation")
+	FVector Normal = FVector::UpVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climb Navigation")
+	EClimbNavNodeType NodeType = EClimbNavNodeType::Ground;
+
+	// How the previous point is left to get here.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category= "Climb Navigation")
+	EClimbNavLinkType ArrivedBy = EClimbNavLinkType::None;
+};
+
+/**
+ * Climb navigation graph of the world: wall cells, ledge tops and the ground around them, linked by climbs, dashes, climb ups,
+ * drop downs and vaults. It is generated from the level geometry once with BuildClimbGraph, after that agents plan routes with
+ * FindClimbPath without probing the world themselves.
+ * Paths are found with a two level A*: a search over clusters of the graph picks the corridor, the node search only expands
+ * nodes inside it. Found paths are cached per start and end node, so agents that share a route share the search too.
+ */
+UCLASS()
+class CLIMBFORGE_API UClimbNavigationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	struct FNode
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Normal = FVector::UpVector;
+		EClimbNavNodeType Type = EClimbNavNodeType::Ground;
+		int32 Cluster = INDEX_NONE;
+
+		// Range of this node's outgoing links in Links.
+		int32 FirstLink = 0;
+		int32 NumLinks = 0;
+	};
+
+	struct FLink
+	{
+		int32 To = INDEX_NONE;
+		float Cost = 0.0f;
+		EClimbNavLinkType Type = EClimbNavLinkType::Climb;
+	};
+
+	struct FCluster
+	{
+		FVector Center = FVector::ZeroVector;
+		TArray<int32> Nodes;
+		// Clusters reachable through at least one link.
+		TArray<int32> Neighbors;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FLink> Links;
+	TArray<FCluster> Clusters;
+	TMap<FIntVector, int32> ClusterLookup;
+	FClimbNavBuildSettings Settings;
+
+	// Node paths keyed by start and end node, empty if there is no route. Oldest entries are dropped first once
+	// Settings.MaxCachedPaths is reached.
+	TMap<uint64, TArray<int32>> PathCache;
+	TArray<uint64> PathCacheOrder;
+	int32 NextPathCacheSlot = 0;
+
+	// Scratch space of the node search. A node's score is only valid if its stamp matches the current search.
+	TArray<float> SearchCost;
+	TArray<int32> SearchParent;
+	TArray<uint32> SearchStamp;
+	uint32 SearchGeneration = 0;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> NavLinkHost;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNavLinkCustomComponent>> NavLinkComponents;
+
+public:
+	// Replace the graph with one generated from the geometry inside the given bounds.
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Navigation")
+	void BuildClimbGraph(const FBox& Bounds, const FClimbNavBuildSettings& InSettings);
+
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Navigation")
+	void ClearClimbGraph();
+
+	// Route from the graph node nearest to Start to the one nearest to End. Returns false if either has no node close enough
+	// or there is no route between them.
+	UFUNCTION(BlueprintCallable, Category= "ClimbForge|Navigation")
+	bool FindClimbPath(const FVector& Start, const FVector& End, TArray<FClimbNavPathPoint>& OutPath);
+
+	UFUNCTION(BlueprintPure, Category= "ClimbForge|Navigation")
+	int32 GetNumClimbNodes() const { return Nodes.Num(); }
+
+	virtual void Deinitialize() override;
+
+private:
+	// Nearest node within one cluster size of the location.
+	int32 FindNearestNode(const FVector& Location) const;
+
+	// Clusters on the high level path and their neighbors. Returns false if the clusters are not connected.
+	bool FindClusterCorridor(const int32 StartCluster, const int32 EndCluster, TBitArray<>& OutCorridor) const;
+
+	// A* over the nodes. Only nodes in the corridor are expanded unless it is null.
+	bool FindNodePath(const int32 StartNode, const int32 EndNode, const TBitArray<>* Corridor, TArray<int32>& OutNodePath);
+
+	void AddCachedPath(const uint64 Key, const TArray<int32>& NodePath);
+
+	EClimbNavLinkType GetLinkType(const int32 From, const int32 To) const;
+
+	int32 GetOrAddCluster(const FVector& Location);
+
+	void RegisterNavLinks(const TArray<TPair<int32, int32>>& NavLinkPairs);
+	void UnregisterNavLinks();
+
+	// A path following reached the start of a climb nav link, hand it to the climber.
+	void OnClimbNavLinkReached(UNavLinkCustomComponent* Link, UObject* PathComp, const FVector& DestPoint);
+};
@@ -0,0 +1,77 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+#include "Engine/NetSerialization.h"
+#include "ClimbPredictedAction.generated.h"
+
+// Climb actions that the owning client starts right away and the server confirms afterwards. Getting on and off the wall is one of
+// them as well, the server only climbs because of these.
+UENUM()
+enum class EClimbPredictedAction : uint8
+{
+	None,
+	Dash,
+	Vault,
+	LedgeClimb,
+	// Idle to climb montage, climbing starts once it ends.
+	ClimbStart,
+	// Climb down from ledge montage, climbing starts once it ends.
+	ClimbDown,
+	// Grab a ledge while falling.
+	Hang,
+	// Let go of the wall or ledge.
+	LetGo
+};
+
+// What the client started and with which warp targets, sent to the server for validation.
+USTRUCT()
+struct FClimbPredictedActionRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint8 RequestId = 0;
+
+	UPROPERTY()
+	EClimbPredictedAction Action = EClimbPredictedAction::None;
+
+	UPROPERTY()
+	EClimbingDirection Direction = EClimbingDirection::Idle;
+
+	// HopHitPoint for a dash, VaultStart for a vault and the ledge target for a ledge climb.
+	UPROPERTY()
+	FVector_NetQuantize10 WarpTarget = FVector::ZeroVector;
+
+	// VaultLand for a vault, unused otherwise.
+	UPROPERTY()
+	FVector_NetQuantize10 SecondaryWarpTarget = FVector::ZeroVector;
+};
+
+// The server's answer to a FClimbPredictedActionRequest.
+USTRUCT()
+struct FClimbPredictedActionResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint8 RequestId = 0;
+
+	// False when the server's own queries say the action is not possible. The client cancels it.
+	UPROPERTY()
+	bool bAccepted = false;
+
+	// True when the server accepted the action but with different warp targets. The client switches to them mid montage.
+	UPROPERTY()
+	bool bCorrected = false;
+
+	UPROPERTY()
+	FVector_NetQuantize10 WarpTarget = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantize10 SecondaryWarpTarget = FVector::ZeroVector;
+};
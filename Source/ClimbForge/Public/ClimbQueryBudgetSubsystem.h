@@ -0,0 +1,74 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ClimbQueryBudgetSubsystem.generated.h"
+
+class UClimbForgeMovementComponent;
+
+// Lower is served first.
+enum class EClimbQueryPriority : uint8
+{
+	// Player controlled climbers are never deferred.
+	Player,
+	// AI that was rendered recently and is close to a local player's view.
+	Visible,
+	// Off-screen or far away AI.
+	Hidden
+};
+
+/**
+ * Caps how many climbers run their optional climb queries (the surface sweep while walking, climb and vault checks) in a frame,
+ * see ClimbForge.QueryBudget. The ledge check of a climber on a wall is not optional and never asks for a slot.
+ * Climbers that ask once the frame's budget is used up are deferred. At the end of the frame the deferred ones are sorted by
+ * priority, with every waited frame counting towards the next priority, and the first ones get a slot reserved for the next frame.
+ * Players are always admitted, so the worst case per frame is the budget plus the number of players.
+ */
+UCLASS()
+class CLIMBFORGE_API UClimbQueryBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	struct FRequest
+	{
+		// Last frames the climber asked in and was admitted in.
+		uint64 LastRequestFrame = 0;
+		uint64 AdmittedFrame = 0;
+
+		// When the climber was first turned away, zero if it is not waiting.
+		uint64 DeferredFrame = 0;
+		double DeferredTime = 0.0;
+
+		EClimbQueryPriority Priority = EClimbQueryPriority::Hidden;
+
+		// A slot of the current frame is reserved for it.
+		bool bHasReservedSlot = false;
+	};
+
+	TMap<TObjectKey<UClimbForgeMovementComponent>, FRequest> Requests;
+
+	// Non-player climbers admitted this frame, and slots still held for climbers that were deferred before.
+	int32 NumAdmitted = 0;
+	int32 NumReserved = 0;
+
+	// Waits that ended this frame, for the stats.
+	int32 NumWaitsFinished = 0;
+	double TotalWaitSeconds = 0.0;
+	double MaxWaitSeconds = 0.0;
+
+public:
+	// Returns true if the climber may run its climb queries this frame. Asking again in the same frame is free.
+	// A climber that is turned away should ask again next frame, it keeps its place in the queue as long as it does.
+	bool TryAdmit(const UClimbForgeMovementComponent& Climber);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	EClimbQueryPriority GetPriority(const UClimbForgeMovementComponent& Climber) const;
+};
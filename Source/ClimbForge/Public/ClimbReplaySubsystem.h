@@ -0,0 +1,211 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbReplaySubsystem.generated.h"
+
+class AClimbForgeCharacter;
+enum class EVisibilityBasedAnimTickOption : uint8;
+
+UENUM()
+enum class EClimbRecordedAction : uint8
+{
+	Climb,
+	ClimbMove,
+	ClimbHop,
+	Move,
+	// Not an input action. The control rotation the look input ended up at, ground movement is relative to it.
+	ControlRotation
+};
+
+USTRUCT()
+struct FClimbRecordedInput
+{
+	GENERATED_BODY()
+
+	// Seconds since the recording started.
+	UPROPERTY()
+	float Time = 0.0f;
+
+	UPROPERTY()
+	EClimbRecordedAction Action = EClimbRecordedAction::Climb;
+
+	UPROPERTY()
+	EInputActionValueType ValueType = EInputActionValueType::Boolean;
+
+	// The action value, or pitch, yaw and roll for ControlRotation.
+	UPROPERTY()
+	FVector Value = FVector::ZeroVector;
+};
+
+USTRUCT()
+struct FClimbInputRecording
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString MapName;
+
+	UPROPERTY()
+	FTransform StartTransform;
+
+	UPROPERTY()
+	FRotator StartControlRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	float Duration = 0.0f;
+
+	// Started actions once per press. Held axis actions only when their value changes, a release is recorded as zero.
+	UPROPERTY()
+	TArray<FClimbRecordedInput> Inputs;
+};
+
+USTRUCT()
+struct FClimbReplaySample
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+};
+
+USTRUCT()
+struct FClimbReplayTimelineEntry
+{
+	GENERATED_BODY()
+
+	// Replay frame the movement mode or montage changed in.
+	UPROPERTY()
+	int32 Frame = 0;
+
+	UPROPERTY()
+	FString Name;
+};
+
+// What a replay produced. Stored as the golden file, a later replay of the same recording has to match it.
+USTRUCT()
+struct FClimbReplayResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	float FixedDeltaTime = 0.0f;
+
+	// Actor transform at the end of every replay frame.
+	UPROPERTY()
+	TArray<FClimbReplaySample> Trajectory;
+
+	UPROPERTY()
+	TArray<FClimbReplayTimelineEntry> MovementModes;
+
+	// Active montage, "None" once no montage plays.
+	UPROPERTY()
+	TArray<FClimbReplayTimelineEntry> Montages;
+
+	// Wall clock time of the replay frames. Nothing waits between frames at a fixed time step, so this is the frame cost.
+	UPROPERTY()
+	double TotalMs = 0.0;
+
+	UPROPERTY()
+	double AverageFrameMs = 0.0;
+
+	UPROPERTY()
+	double P95FrameMs = 0.0;
+
+	UPROPERTY()
+	double MaxFrameMs = 0.0;
+};
+
+/**
+ * Records the climb relevant input that reaches the player's AClimbForgeCharacter and replays it at a fixed time step, so a change to
+ * the climb movement can be checked for producing the same motion as before.
+ * A replay captures the trajectory, the movement mode timeline and the montage timeline, and compares them against a golden file within
+ * the ClimbForge.Replay.* tolerances. It also times every frame, so each replay is a performance run as well.
+ *
+ * Record in game with ClimbForge.RecordInput, start walking, run it again with a file path to stop and save.
+ * Replay headless with: <Project> <Map> -game -nullrhi -unattended -ClimbReplay=<Recording> [-ClimbReplayGolden=<Golden>]
+ * [-ClimbReplayUpdateGolden] [-ClimbReplayFPS=60]. The process exits with 0 if the replay matched and 1 if it did not, or if no
+ * player character showed up to replay it on.
+ */
+UCLASS()
+class CLIMBFORGE_API UClimbReplaySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	enum class EState : uint8
+	{
+		Idle,
+		Recording,
+		// A replay was asked for on the command line, waiting for the player character.
+		ReplayPending,
+		Replaying
+	};
+
+	EState State = EState::Idle;
+
+	TWeakObjectPtr<AClimbForgeCharacter> Character;
+	FClimbInputRecording Recording;
+	double RecordingStartTime = 0.0;
+
+	// Last recorded value per held action, so only changes are recorded.
+	FVector LastMoveValue = FVector::ZeroVector;
+	FVector LastClimbMoveValue = FVector::ZeroVector;
+	FRotator LastControlRotation = FRotator::ZeroRotator;
+
+	FString RecordingPath;
+	FString GoldenPath;
+	bool bUpdateGolden = false;
+	bool bExitWhenDone = false;
+	float ReplayDeltaTime = 1.0f / 60.0f;
+	bool bHadFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+	EVisibilityBasedAnimTickOption PreviousAnimTickOption{};
+	double ReplayPendingStartTime = 0.0;
+
+	int32 ReplayFrame = 0;
+	int32 NextInput = 0;
+	FInputActionValue HeldMove;
+	FInputActionValue HeldClimbMove;
+	FClimbReplayResult Result;
+	double LastFrameTime = 0.0;
+	TArray<double> FrameMs;
+
+public:
+	// Start recording the given character's input. It has to be on the ground.
+	bool StartRecording(AClimbForgeCharacter& InCharacter);
+
+	// Stop recording and save it. Returns false if nothing was recorded or the file could not be written.
+	bool StopRecording(const FString& FilePath);
+
+	FORCEINLINE bool IsRecording() const { return State == EState::Recording; }
+
+	// Called by the recorded character for every action that reaches it.
+	void RecordInput(const EClimbRecordedAction Action, const FInputActionValue& Value);
+
+	// Replay a recording on the player character. Compares against the golden file if there is one, writes it if bInUpdateGolden is set.
+	bool StartReplay(const FString& InRecordingPath, const FString& InGoldenPath, const bool bInUpdateGolden);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void SampleControlRotation();
+
+	void TickReplay();
+	void CaptureFrame();
+	void FinishReplay();
+
+	// Logs every mismatch, returns true if there was none.
+	bool CompareWithGolden(const FClimbReplayResult& Golden) const;
+
+	FString GetMovementModeName() const;
+};
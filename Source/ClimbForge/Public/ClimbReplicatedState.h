@@ -0,0 +1,65 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+#include "ClimbReplicatedState.generated.h"
+
+/**
+ * The climb state simulated proxies need to pose a remote climber, in its quantized form.
+ * Values are quantized when they are set so that an unchanged state compares equal and is not sent again.
+ *  - Surface normal: octahedral encoding, 12 bits per axis.
+ *  - Surface location and ledge target: integer centimeters relative to the pawn.
+ *  - Dash direction: 3 bits.
+ * Iris picks up NetSerialize through the SupportsStructNetSerializerList entry in DefaultEngine.ini.
+ */
+USTRUCT()
+struct CLIMBFORGE_API FClimbReplicatedState
+{
+	GENERATED_BODY()
+
+private:
+	uint32 PackedSurfaceNormal = 0;
+	FIntVector SurfaceLocationOffset = FIntVector::ZeroValue;
+	FIntVector LedgeTargetOffset = FIntVector::ZeroValue;
+	EClimbingDirection DashDirection = EClimbingDirection::Idle;
+	bool bHasLedgeTarget = false;
+	bool bMoveToTargetAfterClimb = false;
+
+public:
+	void SetSurface(const FVector& InNormal, const FVector& InLocation, const FVector& InPawnLocation);
+	// Clears the target instead if it is further from the pawn than the quantized offset can hold.
+	void SetLedgeTarget(const FVector& InLedgeTarget, const FVector& InPawnLocation);
+	void ClearLedgeTarget();
+	FORCEINLINE void SetDashDirection(const EClimbingDirection InDirection) { DashDirection = InDirection; }
+	FORCEINLINE void SetMoveToTargetAfterClimb(const bool bInMoveToTarget) { bMoveToTargetAfterClimb = bInMoveToTarget; }
+
+	FVector GetSurfaceNormal() const;
+	FVector GetSurfaceLocation(const FVector& InPawnLocation) const;
+	FORCEINLINE bool HasLedgeTarget() const { return bHasLedgeTarget; }
+	FVector GetLedgeTarget(const FVector& InPawnLocation) const;
+	FORCEINLINE EClimbingDirection GetDashDirection() const { return DashDirection; }
+	FORCEINLINE bool ShouldMoveToTargetAfterClimb() const { return bMoveToTargetAfterClimb; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FClimbReplicatedState& Other) const
+	{
+		return PackedSurfaceNormal == Other.PackedSurfaceNormal && SurfaceLocationOffset == Other.SurfaceLocationOffset &&
+			LedgeTargetOffset == Other.LedgeTargetOffset && DashDirection == Other.DashDirection &&
+			bHasLedgeTarget == Other.bHasLedgeTarget && bMoveToTargetAfterClimb == Other.bMoveToTargetAfterClimb;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbReplicatedState> : public TStructOpsTypeTraitsBase2<FClimbReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
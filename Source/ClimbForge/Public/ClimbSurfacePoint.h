@@ -0,0 +1,75 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+// A point and normal found on a climbable surface. When the surface belongs to a movable component they are kept in that
+// component's space, so a cached hold or target rides along with a moving platform without being traced again.
+struct FClimbSurfacePoint
+{
+	// The component the point was found on. Only set when it is movable, static surfaces are stored in world space.
+	TWeakObjectPtr<const USceneComponent> Base;
+
+	// In the space of Base when it is set, in world space otherwise.
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+
+	// World space copy from when the point was set. Used if the base goes away.
+	FVector LastWorldLocation = FVector::ZeroVector;
+	FVector LastWorldNormal = FVector::ZeroVector;
+
+	bool bIsSet = false;
+
+	void Set(const FVector& WorldLocation, const FVector& WorldNormal, const USceneComponent* InBase)
+	{
+		LastWorldLocation = WorldLocation;
+		LastWorldNormal = WorldNormal;
+		bIsSet = true;
+
+		if (InBase != nullptr && InBase->Mobility == EComponentMobility::Movable)
+		{
+			const FTransform& BaseTransform = InBase->GetComponentTransform();
+			Base = InBase;
+			Location = BaseTransform.InverseTransformPosition(WorldLocation);
+			Normal = BaseTransform.InverseTransformVectorNoScale(WorldNormal);
+		}
+		else
+		{
+			Base.Reset();
+			Location = WorldLocation;
+			Normal = WorldNormal;
+		}
+	}
+
+	// Move the point to a new world location on the same base, for targets corrected from elsewhere.
+	FORCEINLINE void SetLocation(const FVector& WorldLocation)
+	{
+		Set(WorldLocation, GetNormal(), Base.Get());
+	}
+
+	void Reset()
+	{
+		*this = FClimbSurfacePoint();
+	}
+
+	FORCEINLINE bool IsSet() const { return bIsSet; }
+	FORCEINLINE bool IsBased() const { return Base.IsValid(); }
+
+	FORCEINLINE FVector GetLocation() const
+	{
+		const USceneComponent* BaseComponent = Base.Get();
+		if (BaseComponent != nullptr) return BaseComponent->GetComponentTransform().TransformPosition(Location);
+		return Base.IsExplicitlyNull() ? Location : LastWorldLocation;
+	}
+
+	FORCEINLINE FVector GetNormal() const
+	{
+		const USceneComponent* BaseComponent = Base.Get();
+		if (BaseComponent != nullptr) return BaseComponent->GetComponentTransform().TransformVectorNoScale(Normal);
+		return Base.IsExplicitlyNull() ? Normal : LastWorldNormal;
+	}
+};
@@ -0,0 +1,93 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+
+// Climb telemetry is for playtests, Shipping builds record nothing.
+#ifndef CLIMBFORGE_WITH_TELEMETRY
+	#define CLIMBFORGE_WITH_TELEMETRY !UE_BUILD_SHIPPING
+#endif
+
+enum class EClimbTelemetryEventType : uint8
+{
+	ClimbStart,
+	ClimbStop,
+	VaultStart,
+	VaultFail,
+	DashStart,
+	DashFail
+};
+
+enum class EClimbStopReason : uint8
+{
+	None,
+	LetGo,
+	NoSurface,
+	UnclimbableSurface,
+	ReachedFloor,
+	LostLedge
+};
+
+enum class EClimbVaultFailReason : uint8
+{
+	None,
+	Falling,
+	NoObstacle,
+	ObstacleTooHigh,
+	NoLanding,
+	Busy
+};
+
+enum class EClimbDashFailReason : uint8
+{
+	None,
+	InvalidDirection,
+	NoTarget,
+	Busy
+};
+
+const TCHAR* LexToString(const EClimbStopReason Reason);
+const TCHAR* LexToString(const EClimbVaultFailReason Reason);
+const TCHAR* LexToString(const EClimbDashFailReason Reason);
+
+// One entry of the telemetry stream. Reason holds the stop, vault or dash fail reason matching Type.
+struct FClimbTelemetryEvent
+{
+	double Time = 0.0;
+	uint64 Frame = 0;
+	FVector3f Location = FVector3f::ZeroVector;
+	uint32 ActorId = 0;
+	EClimbTelemetryEventType Type = EClimbTelemetryEventType::ClimbStart;
+	uint8 Reason = 0;
+	EClimbingDirection Direction = EClimbingDirection::Idle;
+};
+
+#if CLIMBFORGE_WITH_TELEMETRY
+
+namespace ClimbTelemetry
+{
+	// Append an event to the calling thread's ring buffer. The oldest events are overwritten once it is full.
+	void RecordEvent(const EClimbTelemetryEventType Type, const AActor* Actor, const uint8 Reason, const EClimbingDirection Direction);
+
+	template<typename TReason = uint8>
+	FORCEINLINE void Record(const EClimbTelemetryEventType Type, const AActor* Actor, const TReason Reason = TReason(0),
+		const EClimbingDirection Direction = EClimbingDirection::Idle)
+	{
+		RecordEvent(Type, Actor, static_cast<uint8>(Reason), Direction);
+	}
+
+	// Write the events of all threads, oldest first, as CSV. Returns false if the file could not be written.
+	bool DumpToCSV(const FString& FilePath);
+}
+
+#define CLIMB_TELEMETRY(...) ClimbTelemetry::Record(__VA_ARGS__)
+
+#else
+
+#define CLIMB_TELEMETRY(...)
+
+#endif
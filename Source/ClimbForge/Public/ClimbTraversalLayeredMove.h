@@ -0,0 +1,54 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayeredMove.h"
+#include "ClimbTraversalLayeredMove.generated.h"
+
+/**
+ * Carries the capsule along a quadratic curve from Start through Control to Target over DurationMs. This is the Mover
+ * counterpart of the root motion montages and motion warp targets the movement component uses for a ledge climb, a climb dash and a vault.
+ * The capsule flies while it is on the path and switches to ModeAfterTraversal on the last step. The path only depends on
+ * the move's own fields and the simulation time, so it is replayed exactly on a rollback.
+ */
+USTRUCT(BlueprintType)
+struct CLIMBFORGE_API FLayeredMove_ClimbTraversal : public FLayeredMoveBase
+{
+	GENERATED_BODY()
+
+	FLayeredMove_ClimbTraversal();
+	virtual ~FLayeredMove_ClimbTraversal() {}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	FVector Start = FVector::ZeroVector;
+
+	// Pulls the path towards it, e.g. above the climber so that a ledge climb goes up before it goes over the ledge.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	FVector Control = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	FVector Target = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category= "Mover")
+	FName ModeAfterTraversal = NAME_None;
+
+	FVector GetPointAt(const float Alpha) const;
+
+	virtual bool GenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, const UMoverComponent* MoverComp,
+		UMoverBlackboard* SimBlackboard, FProposedMove& OutProposedMove) override;
+	virtual FLayeredMoveBase* Clone() const override;
+	virtual void NetSerialize(FArchive& Ar) override;
+	virtual UScriptStruct* GetScriptStruct() const override;
+	virtual FString ToSimpleString() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLayeredMove_ClimbTraversal> : public TStructOpsTypeTraitsBase2<FLayeredMove_ClimbTraversal>
+{
+	enum
+	{
+		WithCopy = true
+	};
+};
@@ -0,0 +1,40 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbMoverLibrary.h"
+#include "DefaultMovementSet/Modes/WalkingMode.h"
+#include "ClimbWalkingMode.generated.h"
+
+class UClimbMoverSettings;
+class UCommonLegacyMovementSettings;
+
+/**
+ * Mover's walking mode that also starts climbs and vaults. After the walk of a step it acts on the FClimbMoverInputs of the input
+ * command: a climb request switches to the UClimbingMode if there is a wall in front, a vault request queues a vault traversal.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class CLIMBFORGE_API UClimbWalkingMode : public UWalkingMode
+{
+	GENERATED_BODY()
+
+public:
+	UClimbWalkingMode(const FObjectInitializer& ObjectInitializer);
+
+	virtual void OnRegistered(const FName ModeName) override;
+	virtual void OnUnregistered() override;
+
+	virtual void OnSimulationTick(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<const UClimbMoverSettings> ClimbSettings;
+
+	UPROPERTY(Transient)
+	TObjectPtr<const UCommonLegacyMovementSettings> WalkSettings;
+
+	// Scratch of the climbable surface sweep.
+	FClimbMoverScratch Scratch;
+};
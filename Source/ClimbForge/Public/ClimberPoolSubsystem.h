@@ -0,0 +1,55 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimberPoolSubsystem.generated.h"
+
+class AClimbForgeCharacter;
+
+USTRUCT()
+struct FClimberPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AClimbForgeCharacter>> FreeClimbers;
+};
+
+/**
+ * Keeps released climbers around so that waves can reuse them instead of spawning new ones.
+ * Spawning a climber builds all of its components, the anim instance and binds the climbing delegates and montage callbacks.
+ * A reused climber only has its climb state reset (see UClimbForgeMovementComponent::ResetClimbState).
+ */
+UCLASS()
+class CLIMBFORGE_API UClimberPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY()
+	TMap<TSubclassOf<AClimbForgeCharacter>, FClimberPool> Pools;
+
+public:
+	// Spawn climbers up front so the first wave does not pay for them.
+	UFUNCTION(BlueprintCallable, Category = "ClimbForge|Pool")
+	void Prewarm(TSubclassOf<AClimbForgeCharacter> ClimberClass, int32 Count);
+
+	// Reuse a free climber of the given class or spawn one if the pool is empty.
+	UFUNCTION(BlueprintCallable, Category = "ClimbForge|Pool")
+	AClimbForgeCharacter* AcquireClimber(TSubclassOf<AClimbForgeCharacter> ClimberClass, const FTransform& SpawnTransform);
+
+	// Hand a climber back to the pool instead of destroying it.
+	UFUNCTION(BlueprintCallable, Category = "ClimbForge|Pool")
+	void ReleaseClimber(AClimbForgeCharacter* Climber);
+
+	UFUNCTION(BlueprintPure, Category = "ClimbForge|Pool")
+	int32 GetNumFreeClimbers(TSubclassOf<AClimbForgeCharacter> ClimberClass) const;
+
+	virtual void Deinitialize() override;
+
+private:
+	AClimbForgeCharacter* SpawnClimber(TSubclassOf<AClimbForgeCharacter> ClimberClass, const FTransform& SpawnTransform) const;
+};
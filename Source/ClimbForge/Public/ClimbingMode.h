@@ -0,0 +1,49 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbMoverLibrary.h"
+#include "MovementMode.h"
+#include "ClimbingMode.generated.h"
+
+class UClimbMoverSettings;
+class UCommonLegacyMovementSettings;
+
+namespace ClimbModeNames
+{
+	const FLazyName Climbing = TEXT("Climbing");
+}
+
+/**
+ * The climbing movement of UClimbForgeMovementComponent as a Mover movement mode, so climbers can run on Mover's fixed tick
+ * and async simulation. It works on the same tunables, see UClimbMoverSettings.
+ * While climbing, the move input is read as the stick: X moves right and Y moves up along the surface.
+ * Reaching the floor lets go onto the walking mode, and running out of surface drops into the falling mode. Reaching a ledge queues
+ * a ledge climb traversal. The FClimbMoverInputs of the input command let go of the wall or queue a climb dash traversal.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class CLIMBFORGE_API UClimbingMode : public UBaseMovementMode
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingMode(const FObjectInitializer& ObjectInitializer);
+
+	virtual void OnRegistered(const FName ModeName) override;
+	virtual void OnUnregistered() override;
+
+	virtual void OnGenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const override;
+	virtual void OnSimulationTick(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<const UClimbMoverSettings> ClimbSettings;
+
+	UPROPERTY(Transient)
+	TObjectPtr<const UCommonLegacyMovementSettings> CommonLegacySettings;
+
+	// Scratch of the contact and floor sweeps.
+	FClimbMoverScratch Scratch;
+};
@@ -4,5 +4,6 @@ UENUM(BlueprintType)
 enum ECustomMovementMode : uint8
 {
 	MOVE_Climbing UMETA(DisplayName="Climb Mode"),
+	MOVE_Hanging UMETA(DisplayName="Hang Mode"),
 	MOVE_CUSTOM_MAX		UMETA(Hidden),
 };
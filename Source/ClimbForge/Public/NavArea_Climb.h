@@ -0,0 +1,21 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavAreas/NavArea.h"
+#include "NavArea_Climb.generated.h"
+
+/**
+ * Area of the nav links the UClimbNavigationSubsystem adds to the navmesh. A path point in this area means the agent has to
+ * climb, vault or drop to reach the next one, the route for it comes from UClimbNavigationSubsystem::FindClimbPath.
+ */
+UCLASS(Config=Engine)
+class CLIMBFORGE_API UNavArea_Climb : public UNavArea
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_Climb(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,21 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavFilter_NoClimb.generated.h"
+
+/**
+ * Query filter for agents that can't climb: it excludes UNavArea_Climb, so their paths never use the climb nav links of the
+ * UClimbNavigationSubsystem. Set it as the default navigation filter class of their AI controller.
+ */
+UCLASS()
+class CLIMBFORGE_API UNavFilter_NoClimb : public UNavigationQueryFilter
+{
+	GENERATED_BODY()
+
+public:
+	UNavFilter_NoClimb(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,18 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+using UnrealBuildTool;
+using System.IO;
+
+// The engine independent climbing math, kept out of the game module so ClimbForgeMathTests can run it without a world.
+public class ClimbForgeMath : ModuleRules
+{
+	public ClimbForgeMath(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject" });
+
+		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Public"));
+	}
+}
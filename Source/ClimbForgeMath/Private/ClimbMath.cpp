@@ -0,0 +1,126 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbMath.h"
+
+ClimbMath::FClimbContactSummary ClimbMath::SummarizeContacts(const FClimbContactBatch& Batch, const FVector& Forward,
+	const float FloorDotThreshold, const float CeilingDotThreshold)
+{
+	FClimbContactSummary Summary;
+	if (Batch.Num == 0) return Summary;
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float PlusBig = VectorSetFloat1(UE_BIG_NUMBER);
+	const VectorRegister4Float MinusBig = VectorSetFloat1(-UE_BIG_NUMBER);
+	const VectorRegister4Float Four = VectorSetFloat1(4.0f);
+	const VectorRegister4Float NumContacts = VectorSetFloat1(static_cast<float>(Batch.Num));
+	// Below this the normal has no horizontal direction, which CanStartClimbing treats as a ceiling or floor.
+	const VectorRegister4Float MinHorizontalLength = VectorSetFloat1(UE_KINDA_SMALL_NUMBER);
+	const VectorRegister4Float ForwardX = VectorSetFloat1(static_cast<float>(Forward.X));
+	const VectorRegister4Float ForwardY = VectorSetFloat1(static_cast<float>(Forward.Y));
+
+	VectorRegister4Float LaneIndex = MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f);
+
+	VectorRegister4Float SumPointX = Zero, SumPointY = Zero, SumPointZ = Zero;
+	VectorRegister4Float SumNormalX = Zero, SumNormalY = Zero, SumNormalZ = Zero;
+	VectorRegister4Float MinSteepness = PlusBig, MaxSteepness = MinusBig;
+	VectorRegister4Float MinUpDot = PlusBig, MaxUpDot = MinusBig;
+	VectorRegister4Float BestFacingDot = MinusBig, BestSteepness = Zero, BestIndex = VectorSetFloat1(-1.0f);
+
+	for (int32 Base = 0; Base < Batch.Num; Base += 4)
+	{
+		// The padding is zero, so it adds nothing to the sums but has to be kept out of the min, max and best.
+		const VectorRegister4Float IsContact = VectorCompareLT(LaneIndex, NumContacts);
+
+		SumPointX = VectorAdd(SumPointX, VectorLoadAligned(Batch.PointX.GetData() + Base));
+		SumPointY = VectorAdd(SumPointY, VectorLoadAligned(Batch.PointY.GetData() + Base));
+		SumPointZ = VectorAdd(SumPointZ, VectorLoadAligned(Batch.PointZ.GetData() + Base));
+		SumNormalX = VectorAdd(SumNormalX, VectorLoadAligned(Batch.ImpactNormalX.GetData() + Base));
+		SumNormalY = VectorAdd(SumNormalY, VectorLoadAligned(Batch.ImpactNormalY.GetData() + Base));
+
+		const VectorRegister4Float ImpactNormalZ = VectorLoadAligned(Batch.ImpactNormalZ.GetData() + Base);
+		SumNormalZ = VectorAdd(SumNormalZ, ImpactNormalZ);
+		MinUpDot = VectorMin(MinUpDot, VectorSelect(IsContact, ImpactNormalZ, PlusBig));
+		MaxUpDot = VectorMax(MaxUpDot, VectorSelect(IsContact, ImpactNormalZ, MinusBig));
+
+		// For a unit normal the dot product with its own horizontal direction is the length of its horizontal part.
+		const VectorRegister4Float NormalX = VectorLoadAligned(Batch.NormalX.GetData() + Base);
+		const VectorRegister4Float NormalY = VectorLoadAligned(Batch.NormalY.GetData() + Base);
+		const VectorRegister4Float Steepness = VectorSqrt(VectorMultiplyAdd(NormalX, NormalX, VectorMultiply(NormalY, NormalY)));
+		MinSteepness = VectorMin(MinSteepness, VectorSelect(IsContact, Steepness, PlusBig));
+		MaxSteepness = VectorMax(MaxSteepness, VectorSelect(IsContact, Steepness, MinusBig));
+
+		// Dot product of the forward vector with the reversed horizontal direction of the normal.
+		const VectorRegister4Float FacingDot = VectorNegate(VectorDivide(VectorMultiplyAdd(ForwardX, NormalX, VectorMultiply(ForwardY, NormalY)),
+			VectorMax(Steepness, MinHorizontalLength)));
+
+		const VectorRegister4Float IsCandidate = VectorBitwiseAnd(IsContact, VectorCompareGT(Steepness, MinHorizontalLength));
+		const VectorRegister4Float IsBetter = VectorBitwiseAnd(IsCandidate, VectorCompareGT(FacingDot, BestFacingDot));
+		BestFacingDot = VectorSelect(IsBetter, FacingDot, BestFacingDot);
+		BestSteepness = VectorSelect(IsBetter, Steepness, BestSteepness);
+		BestIndex = VectorSelect(IsBetter, LaneIndex, BestIndex);
+
+		LaneIndex = VectorAdd(LaneIndex, Four);
+	}
+
+	// Reduce the four lanes.
+	alignas(16) float Lanes[13][4];
+	const VectorRegister4Float* Registers[] = { &SumPointX, &SumPointY, &SumPointZ, &SumNormalX, &SumNormalY, &SumNormalZ,
+		&MinSteepness, &MaxSteepness, &MinUpDot, &MaxUpDot, &BestFacingDot, &BestSteepness, &BestIndex };
+	for (int32 Register = 0; Register < UE_ARRAY_COUNT(Registers); ++Register)
+	{
+		VectorStoreAligned(*Registers[Register], Lanes[Register]);
+	}
+
+	const auto Sum = [](const float* Lane) { return Lane[0] + Lane[1] + Lane[2] + Lane[3]; };
+	const auto Min = [](const float* Lane) { return FMath::Min(FMath::Min(Lane[0], Lane[1]), FMath::Min(Lane[2], Lane[3])); };
+	const auto Max = [](const float* Lane) { return FMath::Max(FMath::Max(Lane[0], Lane[1]), FMath::Max(Lane[2], Lane[3])); };
+
+	Summary.AverageLocation = Batch.Origin + FVector(Sum(Lanes[0]), Sum(Lanes[1]), Sum(Lanes[2])) / Batch.Num;
+	Summary.AverageNormal = FVector(Sum(Lanes[3]), Sum(Lanes[4]), Sum(Lanes[5])).GetSafeNormal();
+	Summary.MinSteepness = Min(Lanes[6]);
+	Summary.MaxSteepness = Max(Lanes[7]);
+	Summary.MinUpDot = Min(Lanes[8]);
+	Summary.MaxUpDot = Max(Lanes[9]);
+	Summary.bHasFloorContact = Summary.MaxUpDot > FloorDotThreshold;
+	Summary.bHasCeilingContact = Summary.MinUpDot < CeilingDotThreshold;
+
+	// Ties go to the earlier contact.
+	float BestFacingDotValue = -UE_BIG_NUMBER;
+	for (int32 Lane = 0; Lane < 4; ++Lane)
+	{
+		const int32 Index = static_cast<int32>(Lanes[12][Lane]);
+		if (Index == INDEX_NONE) continue;
+
+		if (Lanes[10][Lane] > BestFacingDotValue || (Lanes[10][Lane] == BestFacingDotValue && Index < Summary.BestCandidate))
+		{
+			BestFacingDotValue = Lanes[10][Lane];
+			Summary.BestCandidate = Index;
+			Summary.BestCandidateSteepness = Lanes[11][Lane];
+		}
+	}
+
+	if (Summary.BestCandidate != INDEX_NONE)
+	{
+		Summary.BestCandidateAngleInDegrees = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(BestFacingDotValue, -1.0f, 1.0f)));
+	}
+	return Summary;
+}
+
+int32 ClimbMath::FindFirstHeightBelow(const TArray<float, TAlignedHeapAllocator<16>>& Heights, const int32 Num, const float Threshold)
+{
+	check(Heights.Num() >= Align(Num, 4));
+
+	const VectorRegister4Float ThresholdRegister = VectorSetFloat1(Threshold);
+	for (int32 Base = 0; Base < Num; Base += 4)
+	{
+		const uint32 BelowMask = static_cast<uint32>(VectorMaskBits(VectorCompareLT(VectorLoadAligned(Heights.GetData() + Base), ThresholdRegister)));
+		if (BelowMask != 0)
+		{
+			const int32 Index = Base + static_cast<int32>(FMath::CountTrailingZeros(BelowMask));
+			return Index < Num ? Index : INDEX_NONE;
+		}
+	}
+	return INDEX_NONE;
+}
@@ -0,0 +1,136 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingDirection.h"
+
+// The math kernels of the climbing movement. They only depend on Core and EClimbingDirection so they can be run without a world,
+// ClimbForgeMathTests checks and benchmarks them against a scalar reference.
+namespace ClimbMath
+{
+	// Define Thresholds for Non-Climbable Surfaces.
+	// These values determine what is considered a "floor" or a "ceiling".
+	// You will likely need to fine-tune these based on your game's specific needs and level design.
+
+	// Threshold for a non-climbable floor:
+	// If the normal points mostly UP (aligned with PlayerUpVector), it's a floor.
+	// A dot product close to 1.0 indicates a floor.
+	constexpr float FloorDotProductThreshold = 0.8f; // Example: Normal is within ~37 degrees of pure up
+
+	// Threshold for a non-climbable ceiling:
+	// If the normal points mostly DOWN (opposite to PlayerUpVector), it's a ceiling.
+	// A dot product close to -1.0 indicates a ceiling.
+	constexpr float CeilingDotProductThreshold = -0.985f; // Example: Normal is within ~37 degrees of pure down
+
+	// Contacts packed as a structure of arrays for SummarizeContacts. Points are stored relative to Origin so they keep
+	// their precision as floats in large worlds. The arrays are zero padded to a multiple of 4.
+	struct FClimbContactBatch
+	{
+		FVector Origin = FVector::ZeroVector;
+		TArray<float, TAlignedHeapAllocator<16>> PointX, PointY, PointZ;
+		TArray<float, TAlignedHeapAllocator<16>> ImpactNormalX, ImpactNormalY, ImpactNormalZ;
+		TArray<float, TAlignedHeapAllocator<16>> NormalX, NormalY, NormalZ;
+		int32 Num = 0;
+
+		// TContact needs ImpactPoint, ImpactNormal and Normal, like FHitResult does. Reuses the allocations of the last call.
+		template<typename TContact>
+		void Assign(const TArrayView<const TContact> Contacts)
+		{
+			Num = Contacts.Num();
+			Origin = Num > 0 ? FVector(Contacts[0].ImpactPoint) : FVector::ZeroVector;
+
+			const int32 PaddedNum = Align(Num, 4);
+			for (TArray<float, TAlignedHeapAllocator<16>>* Array : { &PointX, &PointY, &PointZ, &ImpactNormalX, &ImpactNormalY, &ImpactNormalZ,
+				&NormalX, &NormalY, &NormalZ })
+			{
+				Array->SetNumUninitialized(PaddedNum, EAllowShrinking::No);
+				FMemory::Memzero(Array->GetData() + Num, (PaddedNum - Num) * sizeof(float));
+			}
+
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				const TContact& Contact = Contacts[Index];
+				const FVector Point = Contact.ImpactPoint - Origin;
+				PointX[Index] = Point.X;
+				PointY[Index] = Point.Y;
+				PointZ[Index] = Point.Z;
+				ImpactNormalX[Index] = Contact.ImpactNormal.X;
+				ImpactNormalY[Index] = Contact.ImpactNormal.Y;
+				ImpactNormalZ[Index] = Contact.ImpactNormal.Z;
+				NormalX[Index] = Contact.Normal.X;
+				NormalY[Index] = Contact.Normal.Y;
+				NormalZ[Index] = Contact.Normal.Z;
+			}
+		}
+	};
+
+	// Everything the climbing queries need to know about a set of contacts, see SummarizeContacts.
+	struct FClimbContactSummary
+	{
+		// Average of the impact points and the normalized average of the impact normals.
+		FVector AverageLocation = FVector::ZeroVector;
+		FVector AverageNormal = FVector::ZeroVector;
+
+		// Range of the contact steepness, how much of the sweep normal lies in the horizontal plane. 1 for a vertical wall and 0 for a
+		// floor or ceiling.
+		float MinSteepness = 0.0f;
+		float MaxSteepness = 0.0f;
+
+		// Range of the impact normals' dot product with world up.
+		float MinUpDot = 0.0f;
+		float MaxUpDot = 0.0f;
+		bool bHasFloorContact = false;
+		bool bHasCeilingContact = false;
+
+		// The contact that faces the character the most and is not a floor or ceiling. INDEX_NONE if there is none. Its angle is the one
+		// between the character forward and the sweep normal projected onto the horizontal plane.
+		int32 BestCandidate = INDEX_NONE;
+		float BestCandidateAngleInDegrees = 0.0f;
+		float BestCandidateSteepness = 0.0f;
+	};
+
+	// One SIMD pass over the batch that produces the whole summary. Candidates are classified by the steepness and facing angle of
+	// their sweep normals, floor and ceiling contacts use the impact normals and the given dot product thresholds.
+	CLIMBFORGEMATH_API FClimbContactSummary SummarizeContacts(const FClimbContactBatch& Batch, const FVector& Forward,
+		const float FloorDotThreshold, const float CeilingDotThreshold);
+
+	// Index of the first of the Num heights that is below Threshold, four heights per SIMD compare. INDEX_NONE if there is none.
+	// Heights has to be padded to a multiple of 4, with padding that is not below Threshold.
+	CLIMBFORGEMATH_API int32 FindFirstHeightBelow(const TArray<float, TAlignedHeapAllocator<16>>& Heights, const int32 Num, const float Threshold);
+
+	// Rotation that faces the surface, the character looks against the surface normal.
+	FORCEINLINE FQuat GetSurfaceFacingRotation(const FVector& SurfaceNormal)
+	{
+		return FRotationMatrix::MakeFromX(-1.0f*SurfaceNormal).ToQuat();
+	}
+
+	// True if the normal points mostly up (floor) or mostly down (ceiling) given the dot product thresholds against world up.
+	FORCEINLINE bool IsFloorOrCeilingNormal(const FVector& SurfaceNormal, const float FloorDotThreshold, const float CeilingDotThreshold)
+	{
+		const float DotProduct = FVector::DotProduct(SurfaceNormal, FVector::UpVector);
+		return DotProduct < CeilingDotThreshold || DotProduct > FloorDotThreshold;
+	}
+
+	// Pick the dash direction from how well the input lines up with the up and right axes. Idle if it lines up with neither.
+	FORCEINLINE EClimbingDirection ResolveDashDirection(const float VerticalAxisDot, const float HorizontalAxisDot, const float Threshold = 0.9f)
+	{
+		if (VerticalAxisDot > Threshold) return EClimbingDirection::Up;
+		if (VerticalAxisDot < -Threshold) return EClimbingDirection::Down;
+		if (HorizontalAxisDot > Threshold) return EClimbingDirection::Right;
+		if (HorizontalAxisDot < -Threshold) return EClimbingDirection::Left;
+		return EClimbingDirection::Idle;
+	}
+
+	// The Vector (distance and direction) required to snap the actor to the climbable surface.
+	FORCEINLINE FVector GetSnapVector(const FVector& CurrentLocation, const FVector& Forward, const FVector& SurfaceLocation, const FVector& SurfaceNormal)
+	{
+		// Get the distance between the actor and the climbable surface location and project it onto the plane of the
+		// actor's forward vector. This is the vector facing the surface and having length equal to the distance
+		// between actor and the surface.
+		const FVector ProjectedVector = (SurfaceLocation - CurrentLocation).ProjectOnTo(Forward);
+		return -1.0f*SurfaceNormal*ProjectedVector.Length();
+	}
+}
@@ -0,0 +1,12 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+using UnrealBuildTool;
+
+public class ClimbForgeMathTests : TestModuleRules
+{
+	public ClimbForgeMathTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "ClimbForgeMath" });
+	}
+}
@@ -0,0 +1,22 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+using UnrealBuildTool;
+
+// Headless Low Level Tests (Catch2) for the ClimbForgeMath kernels, no world or engine is booted. On Linux:
+// Engine/Build/BatchFiles/RunUBT.sh ClimbForgeMathTests Linux Development -Project=<Path>/ClimbForge.uproject
+// then run the ClimbForgeMathTests executable from Binaries/Linux. "[ClimbMath]" runs only the correctness checks,
+// "[ClimbMathBenchmark]" only the benchmarks, which report the mean time of one kernel call (ns/op).
+public class ClimbForgeMathTestsTarget : TestTargetRules
+{
+	public ClimbForgeMathTestsTarget(TargetInfo Target) : base(Target)
+	{
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+
+		bCompileAgainstEngine = false;
+		bCompileAgainstApplication = false;
+		// For the EClimbingDirection UENUM in ClimbForgeMath, the tests never create a UObject.
+		bCompileAgainstCoreUObject = true;
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbMathReference.h"
+#include "TestHarness.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <string>
+
+namespace
+{
+	// Contact counts of a climb sweep, from a single hit to a capsule buried in detailed geometry.
+	constexpr int32 ContactCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+	std::string GetBenchmarkName(const char* Kernel, const int32 Num)
+	{
+		return std::string(Kernel) + " " + std::to_string(Num) + (Num == 1 ? " contact" : " contacts");
+	}
+}
+
+// Catch2 reports the mean time of one call, the ns/op of the kernel at that contact count.
+TEST_CASE("ClimbMath::SummarizeContacts scalar vs vectorized", "[ClimbMathBenchmark]")
+{
+	const FVector Forward = FVector(1.0, 0.5, 0.0).GetSafeNormal();
+
+	for (const int32 Num : ContactCounts)
+	{
+		const TArray<ClimbMathReference::FContact> Contacts = ClimbMathReference::MakeContacts(Num, Forward, Num);
+		ClimbMath::FClimbContactBatch Batch;
+		Batch.Assign(MakeArrayView(Contacts));
+
+		BENCHMARK(GetBenchmarkName("Scalar", Num))
+		{
+			return ClimbMathReference::SummarizeContacts(Contacts, Forward, ClimbMath::FloorDotProductThreshold,
+				ClimbMath::CeilingDotProductThreshold);
+		};
+
+		BENCHMARK(GetBenchmarkName("Vectorized", Num))
+		{
+			return ClimbMath::SummarizeContacts(Batch, Forward, ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+		};
+
+		// What the movement component pays per sweep: the contacts are packed into the batch first.
+		BENCHMARK(GetBenchmarkName("Vectorized with packing", Num))
+		{
+			Batch.Assign(MakeArrayView(Contacts));
+			return ClimbMath::SummarizeContacts(Batch, Forward, ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+		};
+	}
+}
+
+// The worst case, the only height below the threshold is the last one.
+TEST_CASE("ClimbMath::FindFirstHeightBelow scalar vs vectorized", "[ClimbMathBenchmark]")
+{
+	constexpr float Threshold = 100.0f;
+
+	for (const int32 Num : ContactCounts)
+	{
+		const TArray<float, TAlignedHeapAllocator<16>> Heights = ClimbMathReference::MakeEdgeHeights(Num, Threshold, Num);
+		const TArrayView<const float> Valid(Heights.GetData(), Num);
+
+		BENCHMARK(GetBenchmarkName("Scalar", Num))
+		{
+			return ClimbMathReference::FindFirstHeightBelow(Valid, Threshold);
+		};
+
+		BENCHMARK(GetBenchmarkName("Vectorized", Num))
+		{
+			return ClimbMath::FindFirstHeightBelow(Heights, Num, Threshold);
+		};
+	}
+}
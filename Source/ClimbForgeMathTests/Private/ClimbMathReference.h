@@ -0,0 +1,124 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbMath.h"
+#include "Math/RandomStream.h"
+
+// Scalar versions of the ClimbMath SIMD kernels. They are the baseline of the benchmarks and what the SIMD results are checked against.
+namespace ClimbMathReference
+{
+	// Same fields SummarizeContacts reads from an FHitResult.
+	struct FContact
+	{
+		FVector ImpactPoint = FVector::ZeroVector;
+		FVector ImpactNormal = FVector::ZeroVector;
+		FVector Normal = FVector::ZeroVector;
+	};
+
+	// Dot product of the forward vector with the reversed horizontal direction of the sweep normal, the facing SummarizeContacts ranks
+	// candidates by.
+	inline float GetFacingDot(const FVector& Forward, const FVector& Normal)
+	{
+		const float Steepness = FMath::Sqrt(static_cast<float>(FMath::Square(Normal.X) + FMath::Square(Normal.Y)));
+		return -static_cast<float>(Forward.X*Normal.X + Forward.Y*Normal.Y) / FMath::Max(Steepness, UE_KINDA_SMALL_NUMBER);
+	}
+
+	// One contact at a time, straight off the array of structures.
+	inline ClimbMath::FClimbContactSummary SummarizeContacts(const TArrayView<const FContact> Contacts, const FVector& Forward,
+		const float FloorDotThreshold, const float CeilingDotThreshold)
+	{
+		ClimbMath::FClimbContactSummary Summary;
+		if (Contacts.IsEmpty()) return Summary;
+
+		Summary.MinSteepness = Summary.MinUpDot = UE_BIG_NUMBER;
+		Summary.MaxSteepness = Summary.MaxUpDot = -UE_BIG_NUMBER;
+		float BestFacingDot = -UE_BIG_NUMBER;
+
+		for (int32 Index = 0; Index < Contacts.Num(); ++Index)
+		{
+			const FContact& Contact = Contacts[Index];
+			Summary.AverageLocation += Contact.ImpactPoint;
+			Summary.AverageNormal += Contact.ImpactNormal;
+
+			const float UpDot = static_cast<float>(Contact.ImpactNormal.Z);
+			Summary.MinUpDot = FMath::Min(Summary.MinUpDot, UpDot);
+			Summary.MaxUpDot = FMath::Max(Summary.MaxUpDot, UpDot);
+
+			const float Steepness = static_cast<float>(Contact.Normal.Size2D());
+			Summary.MinSteepness = FMath::Min(Summary.MinSteepness, Steepness);
+			Summary.MaxSteepness = FMath::Max(Summary.MaxSteepness, Steepness);
+			if (Steepness <= UE_KINDA_SMALL_NUMBER) continue;
+
+			const float FacingDot = GetFacingDot(Forward, Contact.Normal);
+			if (FacingDot > BestFacingDot)
+			{
+				BestFacingDot = FacingDot;
+				Summary.BestCandidate = Index;
+				Summary.BestCandidateSteepness = Steepness;
+			}
+		}
+
+		Summary.AverageLocation /= Contacts.Num();
+		Summary.AverageNormal = Summary.AverageNormal.GetSafeNormal();
+		Summary.bHasFloorContact = Summary.MaxUpDot > FloorDotThreshold;
+		Summary.bHasCeilingContact = Summary.MinUpDot < CeilingDotThreshold;
+		if (Summary.BestCandidate != INDEX_NONE)
+		{
+			Summary.BestCandidateAngleInDegrees = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(BestFacingDot, -1.0f, 1.0f)));
+		}
+		return Summary;
+	}
+
+	inline int32 FindFirstHeightBelow(const TArrayView<const float> Heights, const float Threshold)
+	{
+		for (int32 Index = 0; Index < Heights.Num(); ++Index)
+		{
+			if (Heights[Index] < Threshold) return Index;
+		}
+		return INDEX_NONE;
+	}
+
+	// A climber's sweep against a wall far from the origin: wall contacts with noisy normals that face -Forward, and every
+	// fifth contact a floor or ceiling one, like the sweep gets at the bottom or top of a wall.
+	inline TArray<FContact> MakeContacts(const int32 Num, const FVector& Forward, const int32 Seed)
+	{
+		const FRandomStream Random(Seed);
+		const FVector WallLocation(250000.0, -180000.0, 3000.0);
+
+		TArray<FContact> Contacts;
+		Contacts.SetNum(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			FContact& Contact = Contacts[Index];
+			Contact.ImpactPoint = WallLocation + Random.GetUnitVector()*Random.FRandRange(0.0f, 60.0f);
+
+			FVector Normal = -Forward;
+			if (Index % 5 == 4)
+			{
+				Normal = Random.FRand() < 0.5f ? FVector::UpVector : FVector::DownVector;
+			}
+			Contact.Normal = (Normal + Random.GetUnitVector()*0.2f).GetSafeNormal();
+			Contact.ImpactNormal = (Contact.Normal + Random.GetUnitVector()*0.05f).GetSafeNormal();
+		}
+		return Contacts;
+	}
+
+	// Heights of the vault edge traces, all on the obstacle except the last, which drops below Threshold. Padded to a multiple of
+	// 4 with UE_BIG_NUMBER like ClimbHeightfield does.
+	inline TArray<float, TAlignedHeapAllocator<16>> MakeEdgeHeights(const int32 Num, const float Threshold, const int32 Seed)
+	{
+		const FRandomStream Random(Seed);
+
+		TArray<float, TAlignedHeapAllocator<16>> Heights;
+		Heights.Init(UE_BIG_NUMBER, Align(Num, 4));
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Heights[Index] = Index == Num - 1 ? Threshold - Random.FRandRange(1.0f, 100.0f) : Threshold + Random.FRandRange(0.0f, 100.0f);
+		}
+		return Heights;
+	}
+}
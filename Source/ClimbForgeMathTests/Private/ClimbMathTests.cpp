@@ -0,0 +1,89 @@
+// Copyright (c) Samarth Shroff. All Rights Reserved.
+// This work is protected under applicable copyright laws in perpetuity.
+// Licensed under the CC BY-NC-ND 4.0 License. See LICENSE file for details.
+
+#include "ClimbMathReference.h"
+#include "TestHarness.h"
+
+namespace
+{
+	// The SIMD pass sums floats relative to the first contact, the reference sums doubles.
+	constexpr float LocationTolerance = 0.01f;
+	constexpr float Tolerance = 1.e-4f;
+}
+
+TEST_CASE("ClimbMath::SummarizeContacts matches the scalar reference", "[ClimbMath]")
+{
+	const FVector Forward = FVector(1.0, 0.5, 0.0).GetSafeNormal();
+	ClimbMath::FClimbContactBatch Batch;
+
+	for (int32 Num = 1; Num <= 64; ++Num)
+	{
+		const TArray<ClimbMathReference::FContact> Contacts = ClimbMathReference::MakeContacts(Num, Forward, Num);
+		Batch.Assign(MakeArrayView(Contacts));
+
+		const ClimbMath::FClimbContactSummary Expected = ClimbMathReference::SummarizeContacts(Contacts, Forward,
+			ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+		const ClimbMath::FClimbContactSummary Actual = ClimbMath::SummarizeContacts(Batch, Forward,
+			ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+
+		INFO("Contacts: " << Num);
+		CHECK(Actual.AverageLocation.Equals(Expected.AverageLocation, LocationTolerance));
+		CHECK(Actual.AverageNormal.Equals(Expected.AverageNormal, Tolerance));
+		CHECK(FMath::IsNearlyEqual(Actual.MinSteepness, Expected.MinSteepness, Tolerance));
+		CHECK(FMath::IsNearlyEqual(Actual.MaxSteepness, Expected.MaxSteepness, Tolerance));
+		CHECK(FMath::IsNearlyEqual(Actual.MinUpDot, Expected.MinUpDot, Tolerance));
+		CHECK(FMath::IsNearlyEqual(Actual.MaxUpDot, Expected.MaxUpDot, Tolerance));
+		CHECK(Actual.bHasFloorContact == Expected.bHasFloorContact);
+		CHECK(Actual.bHasCeilingContact == Expected.bHasCeilingContact);
+
+		// Two contacts can face the climber equally within rounding, either is the right pick then.
+		REQUIRE(Actual.BestCandidate != INDEX_NONE);
+		REQUIRE(Expected.BestCandidate != INDEX_NONE);
+		CHECK(FMath::IsNearlyEqual(ClimbMathReference::GetFacingDot(Forward, Contacts[Actual.BestCandidate].Normal),
+			ClimbMathReference::GetFacingDot(Forward, Contacts[Expected.BestCandidate].Normal), Tolerance));
+		CHECK(FMath::IsNearlyEqual(Actual.BestCandidateAngleInDegrees, Expected.BestCandidateAngleInDegrees, 0.01f));
+	}
+}
+
+TEST_CASE("ClimbMath::SummarizeContacts skips floor and ceiling only contacts", "[ClimbMath]")
+{
+	const TArray<ClimbMathReference::FContact> Contacts = {
+		{ FVector(0.0, 0.0, 0.0), FVector::UpVector, FVector::UpVector },
+		{ FVector(10.0, 0.0, 200.0), FVector::DownVector, FVector::DownVector } };
+
+	ClimbMath::FClimbContactBatch Batch;
+	Batch.Assign(MakeArrayView(Contacts));
+	const ClimbMath::FClimbContactSummary Summary = ClimbMath::SummarizeContacts(Batch, FVector::ForwardVector,
+		ClimbMath::FloorDotProductThreshold, ClimbMath::CeilingDotProductThreshold);
+
+	CHECK(Summary.BestCandidate == INDEX_NONE);
+	CHECK(Summary.bHasFloorContact);
+	CHECK(Summary.bHasCeilingContact);
+	CHECK(Summary.AverageLocation.Equals(FVector(5.0, 0.0, 100.0), LocationTolerance));
+}
+
+TEST_CASE("ClimbMath::FindFirstHeightBelow matches the scalar reference", "[ClimbMath]")
+{
+	constexpr float Threshold = 100.0f;
+	for (int32 Num = 1; Num <= 64; ++Num)
+	{
+		INFO("Heights: " << Num);
+		TArray<float, TAlignedHeapAllocator<16>> Heights = ClimbMathReference::MakeEdgeHeights(Num, Threshold, Num);
+		const TArrayView<const float> Valid(Heights.GetData(), Num);
+		CHECK(ClimbMath::FindFirstHeightBelow(Heights, Num, Threshold) == ClimbMathReference::FindFirstHeightBelow(Valid, Threshold));
+
+		// Nothing below: the padding must not be reported either.
+		Heights[Num - 1] = Threshold;
+		CHECK(ClimbMath::FindFirstHeightBelow(Heights, Num, Threshold) == INDEX_NONE);
+	}
+}
+
+TEST_CASE("ClimbMath::ResolveDashDirection", "[ClimbMath]")
+{
+	CHECK(ClimbMath::ResolveDashDirection(1.0f, 0.0f) == EClimbingDirection::Up);
+	CHECK(ClimbMath::ResolveDashDirection(-1.0f, 0.0f) == EClimbingDirection::Down);
+	CHECK(ClimbMath::ResolveDashDirection(0.0f, 1.0f) == EClimbingDirection::Right);
+	CHECK(ClimbMath::ResolveDashDirection(0.0f, -1.0f) == EClimbingDirection::Left);
+	CHECK(ClimbMath::ResolveDashDirection(0.7f, 0.7f) == EClimbingDirection::Idle);
+}